@@ -0,0 +1,426 @@
+//lock-free shared fraction and sharded accumulator
+
+
+#ifndef ATOMIC_FRACTION_H
+#define ATOMIC_FRACTION_H
+
+#include <cstddef>
+#include <new>
+#include <atomic>
+#include <thread>
+
+#include "FractionCore.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ATOMIC_FRACTION_CMPXCHG16B
+#elif defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define ATOMIC_FRACTION_SYNC16
+#endif
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header implements fractions that can be updated by several threads at once without a mutex.
+  It features:
+	-- AtomicFraction, which keeps numerator and denominator in one 16-byte aligned pair and replaces
+	   both together with a single 128-bit compare-and-swap (cmpxchg16b on x86-64), so a reader can
+	   never see the numerator of one value with the denominator of another
+	-- optional exponential backoff between failed compare-and-swaps for heavily contended values
+	-- ShardedFractionAccumulator, which gives each thread its own cache-line-sized shard to add into
+	   and merges the shards when the total is read
+
+  On x86-64 with GCC or Clang the compare-and-swap is an inline cmpxchg16b. Other targets use the
+  compiler's 16-byte __sync builtin when it is available (e.g. when building with -mcx16) and otherwise
+  fall back to a small spinlock; isLockFree() tells which one is in use.
+
+  Unlike Fraction, an AtomicFraction starts at 0 / 1, since it is meant for running totals.
+ */
+
+
+
+/*====================================	BACKOFF ========================================================
+ *======================================================================================================*/
+
+/* Exponential backoff for compare-and-swap loops: spins with a pause hint, doubling the spin each time
+ * up to a limit, then yields the thread. */
+class FractionBackoff
+{
+public:
+
+	FractionBackoff() : spins( 1 ) {}
+
+	void pause()
+	{
+		if ( spins <= MAX_SPINS )
+		{
+			for ( unsigned int k = 0; k < spins; k++ ) cpuRelax();
+			spins *= 2;
+		}
+		else std::this_thread::yield();
+	}
+
+private:
+
+	static const unsigned int MAX_SPINS = 1024;
+
+	unsigned int spins;
+
+	static void cpuRelax()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		__asm__ __volatile__( "yield" );
+#endif
+	}
+};
+
+
+
+/*====================================	ATOMIC FRACTION ================================================
+ *======================================================================================================*/
+
+class AtomicFraction
+{
+public:
+
+	/* Construct with an initial value (0 / 1 by default). If backoff is true, failed compare-and-swaps
+	 * back off exponentially before retrying. */
+	AtomicFraction( const Fraction &initial = Fraction( 0, 1 ), bool backoff = false ) : useBackoff( backoff )
+	{
+		value.numerator = initial.getNumerator();
+		value.denominator = initial.getDenominator();
+#if !defined(ATOMIC_FRACTION_CMPXCHG16B) && !defined(ATOMIC_FRACTION_SYNC16)
+		lock.clear();
+#endif
+	}
+
+//++++++++ Load and store ++++++++//
+
+	Fraction load() const
+	{
+		Pair current = read();
+		Fraction result;
+		result.setNumerator( current.numerator );
+		result.setDenominator( current.denominator );
+		return result;
+	}
+
+	void store( const Fraction &frac )
+	{
+		exchange( frac );
+	}
+
+	// Replaces the value and returns the previous one
+	Fraction exchange( const Fraction &frac )
+	{
+		return update( Assign( frac ), false );
+	}
+
+	// Replaces the value with desired if it is still equal to expected (same numerator and denominator).
+	// On failure, expected is set to the current value. Returns true on success.
+	bool compareExchange( Fraction &expected, const Fraction &desired )
+	{
+		Pair e = { expected.getNumerator(), expected.getDenominator() };
+		Pair d = { desired.getNumerator(), desired.getDenominator() };
+
+		if ( cas( e, d ) ) return true;
+
+		expected.setNumerator( e.numerator );
+		expected.setDenominator( e.denominator );
+		return false;
+	}
+
+//++++++++ Arithmetic ++++++++//
+
+/*NOTE: like the arithmetic members of Fraction, these reduce the result. The fetch variants return the
+ *      value before the update, the others the value after it. */
+
+	Fraction add( const Fraction &frac )
+	{
+		return update( Add( frac ), true );
+	}
+
+	Fraction sub( const Fraction &frac )
+	{
+		return update( Sub( frac ), true );
+	}
+
+	Fraction mul( const Fraction &frac )
+	{
+		return update( Mul( frac ), true );
+	}
+
+	Fraction div( const Fraction &frac )
+	{
+		return update( Div( frac ), true );
+	}
+
+	Fraction fetchAdd( const Fraction &frac )
+	{
+		return update( Add( frac ), false );
+	}
+
+	Fraction fetchSub( const Fraction &frac )
+	{
+		return update( Sub( frac ), false );
+	}
+
+	/* Applies op( Fraction &value ) in a compare-and-swap loop until it lands. op may run several times
+	 * and must not have side effects. Returns the new value if returnNew is true, the old one otherwise. */
+	template <class Op>
+	Fraction update( Op op, bool returnNew = true )
+	{
+		Pair current = read();
+		FractionBackoff backoff;
+
+		while ( true )
+		{
+			Fraction next;
+			next.setNumerator( current.numerator );
+			next.setDenominator( current.denominator );
+			Fraction previous = next;
+			op( next );
+
+			Pair desired = { next.getNumerator(), next.getDenominator() };
+			if ( cas( current, desired ) ) return returnNew ? next : previous;
+
+			if ( useBackoff ) backoff.pause();
+		}
+	}
+
+	// True if updates use a hardware 128-bit compare-and-swap rather than the spinlock fallback
+	static bool isLockFree()
+	{
+#if defined(ATOMIC_FRACTION_CMPXCHG16B) || defined(ATOMIC_FRACTION_SYNC16)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+private:
+
+	struct Pair
+	{
+		long long numerator;
+		long long denominator;
+	};
+
+	struct Assign
+	{
+		const Fraction &frac;
+		Assign( const Fraction &f ) : frac( f ) {}
+		void operator() ( Fraction &v ) const
+		{
+			v.setNumerator( frac.getNumerator() );
+			v.setDenominator( frac.getDenominator() );
+		}
+	};
+
+	struct Add
+	{
+		const Fraction &frac;
+		Add( const Fraction &f ) : frac( f ) {}
+		void operator() ( Fraction &v ) const { v.add( frac ); }
+	};
+
+	struct Sub
+	{
+		const Fraction &frac;
+		Sub( const Fraction &f ) : frac( f ) {}
+		void operator() ( Fraction &v ) const { v.sub( frac ); }
+	};
+
+	struct Mul
+	{
+		const Fraction &frac;
+		Mul( const Fraction &f ) : frac( f ) {}
+		void operator() ( Fraction &v ) const { v.mul( frac ); }
+	};
+
+	struct Div
+	{
+		const Fraction &frac;
+		Div( const Fraction &f ) : frac( f ) {}
+		void operator() ( Fraction &v ) const { v.div( frac ); }
+	};
+
+	alignas( 16 ) mutable Pair value;
+	bool useBackoff;
+
+#if defined(ATOMIC_FRACTION_CMPXCHG16B)
+
+	// 128-bit compare-and-swap. On failure, expected receives the current value.
+	bool cas( Pair &expected, const Pair &desired ) const
+	{
+		bool swapped;
+		__asm__ __volatile__(
+			"lock cmpxchg16b %1"
+			: "=@ccz" ( swapped ), "+m" ( value ), "+a" ( expected.numerator ), "+d" ( expected.denominator )
+			: "b" ( desired.numerator ), "c" ( desired.denominator )
+			: "memory" );
+		return swapped;
+	}
+
+	// A compare-and-swap of 0 / 0 against itself reads the pair atomically; the denominator is never 0,
+	// so the store side never happens.
+	Pair read() const
+	{
+		const Pair zero = { 0, 0 };
+		Pair current = zero;
+		cas( current, zero );
+		return current;
+	}
+
+#elif defined(ATOMIC_FRACTION_SYNC16)
+
+	static FractionUInt128 pack( const Pair &p )
+	{
+		return ( (FractionUInt128)(unsigned long long)p.denominator << 64 ) | (unsigned long long)p.numerator;
+	}
+
+	static Pair unpack( const FractionUInt128 &v )
+	{
+		Pair p = { (long long)(unsigned long long)v, (long long)(unsigned long long)( v >> 64 ) };
+		return p;
+	}
+
+	bool cas( Pair &expected, const Pair &desired ) const
+	{
+		FractionUInt128 e = pack( expected );
+		FractionUInt128 seen = __sync_val_compare_and_swap( (FractionUInt128 *)&value, e, pack( desired ) );
+		if ( seen == e ) return true;
+		expected = unpack( seen );
+		return false;
+	}
+
+	Pair read() const
+	{
+		return unpack( __sync_val_compare_and_swap( (FractionUInt128 *)&value, 0, 0 ) );
+	}
+
+#else
+
+	mutable std::atomic_flag lock;
+
+	void acquire() const
+	{
+		FractionBackoff backoff;
+		while ( lock.test_and_set( std::memory_order_acquire ) ) backoff.pause();
+	}
+
+	bool cas( Pair &expected, const Pair &desired ) const
+	{
+		acquire();
+		bool swapped = value.numerator == expected.numerator && value.denominator == expected.denominator;
+		if ( swapped ) value = desired;
+		else expected = value;
+		lock.clear( std::memory_order_release );
+		return swapped;
+	}
+
+	Pair read() const
+	{
+		acquire();
+		Pair current = value;
+		lock.clear( std::memory_order_release );
+		return current;
+	}
+
+#endif
+
+	// not copyable: copying would not be atomic
+	AtomicFraction( const AtomicFraction & );
+	void operator= ( const AtomicFraction & );
+};
+
+
+
+/*====================================	SHARDED ACCUMULATOR ============================================
+ *======================================================================================================*/
+
+/* A running total that many threads add into. Each thread is assigned one of a fixed number of shards
+ * (round-robin, on its first update), each shard lives on its own cache line, and total() merges the
+ * shards. Updates from different threads therefore rarely touch the same memory.
+ * total() and reset() are not a single atomic snapshot: updates that race with them may or may not be
+ * included. */
+class ShardedFractionAccumulator
+{
+public:
+
+	// shards defaults to the number of hardware threads
+	ShardedFractionAccumulator( size_t shards = 0 )
+	{
+		if ( shards == 0 ) shards = std::thread::hardware_concurrency();
+		if ( shards == 0 ) shards = 1;
+
+		// new Shard[...] only honours the 64-byte alignment from C++17 on, so the shards are placed by hand
+		// in storage over-allocated by one alignment
+		shardCount = shards;
+		storage = new unsigned char[ shards * sizeof( Shard ) + alignof( Shard ) - 1 ];
+		size_t misalignment = (size_t)storage % alignof( Shard );
+		shard = reinterpret_cast<Shard *>( storage + ( misalignment == 0 ? 0 : alignof( Shard ) - misalignment ) );
+		for ( size_t k = 0; k < shards; k++ ) new ( &shard[k] ) Shard();
+	}
+
+	~ShardedFractionAccumulator()
+	{
+		for ( size_t k = 0; k < shardCount; k++ ) shard[k].~Shard();
+		delete[] storage;
+	}
+
+	void add( const Fraction &frac )
+	{
+		shard[ threadSlot() % shardCount ].value.add( frac );
+	}
+
+	void sub( const Fraction &frac )
+	{
+		shard[ threadSlot() % shardCount ].value.sub( frac );
+	}
+
+	// Sum of all shards
+	Fraction total() const
+	{
+		Fraction sum( 0, 1 );
+		for ( size_t k = 0; k < shardCount; k++ ) sum.add( shard[k].value.load() );
+		return sum;
+	}
+
+	// Sets every shard back to 0
+	void reset()
+	{
+		for ( size_t k = 0; k < shardCount; k++ ) shard[k].value.store( Fraction( 0, 1 ) );
+	}
+
+	size_t shards() const
+	{
+		return shardCount;
+	}
+
+private:
+
+	struct alignas( 64 ) Shard
+	{
+		AtomicFraction value;
+	};
+
+	unsigned char *storage;
+	Shard *shard;                  // shardCount shards, 64-byte aligned, inside storage
+	size_t shardCount;
+
+	// Small integer identifying the calling thread, handed out in order of first use
+	static unsigned int threadSlot()
+	{
+		static std::atomic<unsigned int> next( 0 );
+		static thread_local unsigned int slot = next.fetch_add( 1, std::memory_order_relaxed );
+		return slot;
+	}
+
+	// not copyable
+	ShardedFractionAccumulator( const ShardedFractionAccumulator & );
+	void operator= ( const ShardedFractionAccumulator & );
+};
+
+#endif
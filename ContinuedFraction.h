@@ -0,0 +1,573 @@
+//lazy continued fractions with Gosper's arithmetic
+
+
+#ifndef CONTINUED_FRACTION_H
+#define CONTINUED_FRACTION_H
+
+#include <cstddef>
+#include <cmath>
+#include <climits>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header implements ContinuedFraction, a number held as its regular continued fraction
+  [a0; a1, a2, ...] = a0 + 1 / ( a1 + 1 / ( a2 + ... ) ), with a1, a2, ... at least 1.
+
+  Terms are produced lazily and memoized: a continued fraction built from a Fraction or a double runs
+  Euclid's algorithm one step per requested term, and the result of +, -, * or / on two continued
+  fractions is a source that runs Gosper's algorithm, reading terms of its operands only until the next
+  term of the result is determined. compare(...) and decimal(...) in turn read terms only until the
+  answer is known, so comparing two long products of ratios, or printing the first digits of a long chain
+  of quotients, never computes the low-order part of the exact result.
+
+  Gosper's algorithm keeps the eight coefficients of z = ( a xy + b x + c y + d ) / ( e xy + f x + g y + h )
+  in 128-bit integers where the compiler has them (long long otherwise), since they grow with every term
+  read before the next term of the result is known. The terms themselves are long long. If a coefficient
+  or a term overflows before the requested terms are known, overflow_error is thrown, like the arithmetic
+  members of Fraction. A result with no terms at all (a division by zero) throws
+  invalid_argument when its first term is requested.
+
+  Copies share their terms, so a value can appear in several expressions without being expanded twice.
+  This sharing is not synchronized: a continued fraction and its copies must be used from one thread.
+ */
+
+class ContinuedFraction
+{
+public:
+
+/*====================================	CONSTRUCTORS  ==================================================
+ *======================================================================================================*/
+
+	// Zero
+	ContinuedFraction() : source( new Euclid( 0, 1 ) ) {}
+
+	ContinuedFraction( const long long &num ) : source( new Euclid( num, 1 ) ) {}
+
+	ContinuedFraction( const Fraction &frac ) : source( new Euclid( frac.getNumerator(), frac.getDenominator() ) ) {}
+
+	/* The exact value of a finite double, which is a fraction with a power of two as denominator
+	 * Throws overflow_error exception if the value is not finite, or too large or too small to expand
+	 * with long long terms
+	 * (A named constructor, since a constructor from double would make ContinuedFraction( 3 ) ambiguous.) */
+	static ContinuedFraction fromDouble( const double &value )
+	{
+		return ContinuedFraction( std::shared_ptr<Source>( fromDouble_( value ) ) );
+	}
+
+/*====================================	TERMS ==========================================================
+ *======================================================================================================*/
+
+	// Sets out to term i, computing it if needed. Returns false if the expansion has fewer terms.
+	bool term( const size_t &i, long long &out ) const
+	{
+		return source->term( i, out );
+	}
+
+	// Number of terms computed so far (the expansion may be longer)
+	size_t computedTerms() const
+	{
+		return source->terms.size();
+	}
+
+	// The n-th convergent [a0; a1, ..., an], or the exact value if the expansion is shorter
+	// Throws overflow_error exception if it does not fit in long long
+	Fraction convergent( const size_t &n ) const
+	{
+		// p(k) / q(k) from p(k) = a(k) p(k-1) + p(k-2), and likewise for q
+		Wide p = 1, q = 0, pPrevious = 0, qPrevious = 1;
+		long long t;
+		for ( size_t k = 0; k <= n && term( k, t ); k++ )
+		{
+			Wide pNext, qNext;
+			Fraction::throwIfError( mulAdd_( t, p, pPrevious, pNext ) );
+			Fraction::throwIfError( mulAdd_( t, q, qPrevious, qNext ) );
+			narrow_( pNext );
+			narrow_( qNext );
+			pPrevious = p;
+			qPrevious = q;
+			p = pNext;
+			q = qNext;
+		}
+		return Fraction( (long long)p, (long long)q );
+	}
+
+	// The exact value (the last convergent)
+	Fraction value() const
+	{
+		return convergent( (size_t)-1 );
+	}
+
+	// "[a0; a1, a2, ...]" with at most maxTerms terms, followed by "..." if there are more
+	std::string str( const size_t &maxTerms = 20 ) const
+	{
+		std::string result = "[";
+		long long t;
+		size_t k = 0;
+		for ( ; k < maxTerms && term( k, t ); k++ )
+		{
+			if ( k == 1 ) result += "; ";
+			else if ( k > 1 ) result += ", ";
+			result += std::to_string( t );
+		}
+		if ( k == maxTerms && term( k, t ) ) result += k == 1 ? "; ..." : ", ...";
+		return result + "]";
+	}
+
+/*====================================	ARITHMETIC =====================================================
+ *======================================================================================================*/
+
+/*NOTE: these return at once; the terms of the result are computed when they are first read. */
+
+	ContinuedFraction operator+ ( const ContinuedFraction &other ) const
+	{
+		// ( x + y ) / 1
+		return ContinuedFraction( std::shared_ptr<Source>( new Gosper( source, other.source, 0, 1, 1, 0, 0, 0, 0, 1 ) ) );
+	}
+
+	ContinuedFraction operator- ( const ContinuedFraction &other ) const
+	{
+		// ( x - y ) / 1
+		return ContinuedFraction( std::shared_ptr<Source>( new Gosper( source, other.source, 0, 1, -1, 0, 0, 0, 0, 1 ) ) );
+	}
+
+	ContinuedFraction operator* ( const ContinuedFraction &other ) const
+	{
+		// xy / 1
+		return ContinuedFraction( std::shared_ptr<Source>( new Gosper( source, other.source, 1, 0, 0, 0, 0, 0, 0, 1 ) ) );
+	}
+
+	ContinuedFraction operator/ ( const ContinuedFraction &other ) const
+	{
+		// x / y
+		return ContinuedFraction( std::shared_ptr<Source>( new Gosper( source, other.source, 0, 1, 0, 0, 0, 0, 1, 0 ) ) );
+	}
+
+	ContinuedFraction operator- () const
+	{
+		return ContinuedFraction( 0LL ) - *this;
+	}
+
+/*====================================	COMPARISON =====================================================
+ *======================================================================================================*/
+
+	/* Returns -1, 0 or 1 as the value is smaller than, equal to or larger than other's. Terms are read
+	 * pairwise only up to the first difference, whose position decides the direction. */
+	int compare( const ContinuedFraction &other ) const
+	{
+		for ( size_t k = 0; ; k++ )
+		{
+			long long x, y;
+			bool hasX = term( k, x );
+			bool hasY = other.term( k, y );
+
+			// an expansion that has ended behaves as an infinite next term
+			if ( !hasX && !hasY ) return 0;
+			int order;
+			if ( !hasX ) order = 1;
+			else if ( !hasY ) order = -1;
+			else if ( x != y ) order = x < y ? -1 : 1;
+			else continue;
+
+			// larger terms make the value larger at even positions and smaller at odd ones
+			return k % 2 == 0 ? order : -order;
+		}
+	}
+
+	bool operator== ( const ContinuedFraction &other ) const { return compare( other ) == 0; }
+	bool operator!= ( const ContinuedFraction &other ) const { return compare( other ) != 0; }
+	bool operator< ( const ContinuedFraction &other ) const { return compare( other ) < 0; }
+	bool operator> ( const ContinuedFraction &other ) const { return compare( other ) > 0; }
+	bool operator<= ( const ContinuedFraction &other ) const { return compare( other ) <= 0; }
+	bool operator>= ( const ContinuedFraction &other ) const { return compare( other ) >= 0; }
+
+/*====================================	DECIMAL EXPANSION ==============================================
+ *======================================================================================================*/
+
+	/* The value in decimal with digits digits after the point, truncated toward zero, e.g. "-3.1415".
+	 * A negative value that truncates to zero is written without a sign, e.g. "0.00".
+	 * Each digit reads only the terms needed to determine it. */
+	std::string decimal( const size_t &digits ) const
+	{
+		long long first;
+		if ( !term( 0, first ) ) Fraction::throwIfError( FRACTION_ZERO_DENOMINATOR );
+
+		// z = ( a x + b ) / ( c x + d ) of this value x, negated for negative values
+		bool negative = first < 0;
+		Wide a = negative ? -1 : 1, b = 0, c = 0, d = 1;
+		size_t next = 0;
+		bool done = false;
+		bool nonzero = false;              // a nonzero digit was written, so the sign is shown
+
+		std::string result;
+		for ( size_t k = 0; k <= digits; k++ )
+		{
+			Wide r;
+			while ( !homographicFloor_( a, b, c, d, next > 0 || done, r ) )
+			{
+				long long t;
+				if ( term( next, t ) )
+				{
+					// x = t + 1 / x'
+					Wide na, nc;
+					Fraction::throwIfError( mulAdd_( a, t, b, na ) );
+					Fraction::throwIfError( mulAdd_( c, t, d, nc ) );
+					b = a;
+					d = c;
+					a = na;
+					c = nc;
+					next++;
+				}
+				else
+				{
+					// x' is infinite; z is then constant, so it can only fail to be determined if it is infinite
+					if ( done ) Fraction::throwIfError( FRACTION_ZERO_DENOMINATOR );
+					b = a;
+					d = c;
+					done = true;
+				}
+			}
+
+			if ( r != 0 ) nonzero = true;
+			if ( k == 0 ) result += std::to_string( narrow_( r ) );
+			else result += (char)( '0' + (int)r );
+			if ( k == 0 && digits > 0 ) result += ".";
+
+			// z = 10 * ( z - r ); once it is exactly 0, so are the remaining digits
+			Fraction::throwIfError( mulAdd_( -r, c, a, a ) );
+			Fraction::throwIfError( mulAdd_( -r, d, b, b ) );
+			if ( a == 0 && b == 0 )
+			{
+				result.append( digits - k, '0' );
+				break;
+			}
+			Fraction::throwIfError( mulAdd_( a, 10, 0, a ) );
+			Fraction::throwIfError( mulAdd_( b, 10, 0, b ) );
+		}
+		return negative && nonzero ? "-" + result : result;
+	}
+
+private:
+
+/*====================================	TERM SOURCES ===================================================
+ *======================================================================================================*/
+
+#if defined(__SIZEOF_INT128__)
+	typedef FractionInt128 Wide;
+#else
+	typedef long long Wide;
+#endif
+
+	// Produces the terms of an expansion one at a time and memoizes them
+	struct Source
+	{
+		std::vector<long long> terms;
+		bool finished;
+
+		Source() : finished( false ) {}
+		virtual ~Source() {}
+
+		// Sets t to the next term, or returns false at the end of the expansion
+		virtual bool next( long long &t ) = 0;
+
+		bool term( const size_t &i, long long &out )
+		{
+			while ( terms.size() <= i && !finished )
+			{
+				long long t;
+				if ( next( t ) ) terms.push_back( t );
+				else finished = true;
+			}
+			if ( i >= terms.size() ) return false;
+			out = terms[i];
+			return true;
+		}
+	};
+
+	// Euclid's algorithm on n / d, d > 0
+	struct Euclid : Source
+	{
+		Wide n, d;
+
+		Euclid( const Wide &numerator, const Wide &denominator ) : n( numerator ), d( denominator )
+		{
+			if ( d < 0 )
+			{
+				n = -n;
+				d = -d;
+			}
+		}
+
+		bool next( long long &t )
+		{
+			if ( d == 0 ) return false;
+
+			Wide q = n / d;
+			if ( n % d < 0 ) q--;
+			if ( q > LLONG_MAX || q < LLONG_MIN ) Fraction::throwIfError( FRACTION_OVERFLOW );
+
+			Wide r = n - q * d;
+			n = d;
+			d = r;
+			t = (long long)q;
+			return true;
+		}
+	};
+
+	// Gosper's algorithm for z = ( a xy + b x + c y + d ) / ( e xy + f x + g y + h )
+	struct Gosper : Source
+	{
+		std::shared_ptr<Source> x, y;
+		size_t nextX, nextY;               // index of the next term to read
+		bool doneX, doneY;                 // the input has ended, i.e. its remainder is infinite
+		Wide a, b, c, d, e, f, g, h;
+		bool emitted;
+
+		Gosper( const std::shared_ptr<Source> &cx, const std::shared_ptr<Source> &cy,
+		        const Wide &ca, const Wide &cb, const Wide &cc, const Wide &cd,
+		        const Wide &ce, const Wide &cf, const Wide &cg, const Wide &ch )
+			: x( cx ), y( cy ), nextX( 0 ), nextY( 0 ), doneX( false ), doneY( false ),
+			  a( ca ), b( cb ), c( cc ), d( cd ), e( ce ), f( cf ), g( cg ), h( ch ), emitted( false ) {}
+
+		bool next( long long &t )
+		{
+			while ( true )
+			{
+				// z - r was identically 0: the expansion has ended
+				if ( e == 0 && f == 0 && g == 0 && h == 0 )
+				{
+					if ( !emitted ) Fraction::throwIfError( FRACTION_ZERO_DENOMINATOR );
+					return false;
+				}
+
+				// both inputs are past their first term, so their remainders are in [1, infinity]
+				bool ready = ( nextX > 0 || doneX ) && ( nextY > 0 || doneY );
+				long long spreadX = 0, spreadY = 0;
+				Wide r;
+				if ( ready && determined_( r, spreadX, spreadY ) )
+				{
+					t = narrow_( r );
+					emit_( r );
+					emitted = true;
+					return true;
+				}
+
+				if ( doneX && doneY ) Fraction::throwIfError( FRACTION_OVERFLOW );
+				if ( !doneX && ( doneY || nextX == 0 || ( nextY > 0 && spreadX >= spreadY ) ) ) readX_();
+				else readY_();
+			}
+		}
+
+		// The floor of z over x, y in [1, infinity], if it is the same at all four corners.
+		// Otherwise returns false, with how far apart the corners are in the direction of each input.
+		bool determined_( Wide &r, long long &spreadX, long long &spreadY )
+		{
+			// corners: ( inf, inf ), ( inf, 1 ), ( 1, inf ), ( 1, 1 )
+			Wide n[4], m[4];
+			n[0] = a;
+			m[0] = e;
+			if ( addOverflow_( a, b, n[1] ) || addOverflow_( e, f, m[1] ) ||
+			     addOverflow_( a, c, n[2] ) || addOverflow_( e, g, m[2] ) ||
+			     addOverflow_( n[1], c, n[3] ) || addOverflow_( n[3], d, n[3] ) ||
+			     addOverflow_( m[1], g, m[3] ) || addOverflow_( m[3], h, m[3] ) )
+				Fraction::throwIfError( FRACTION_OVERFLOW );
+
+			// the denominator must keep one sign over the whole box, or z is unbounded there
+			bool bounded = true;
+			for ( int k = 0; k < 4; k++ )
+				if ( m[k] == 0 || ( m[k] < 0 ) != ( m[0] < 0 ) ) bounded = false;
+
+			Wide q[4];
+			if ( bounded )
+			{
+				for ( int k = 0; k < 4; k++ ) Fraction::throwIfError( floorDiv_( n[k], m[k], q[k] ) );
+				if ( q[0] == q[1] && q[1] == q[2] && q[2] == q[3] )
+				{
+					r = q[0];
+					return true;
+				}
+			}
+
+			// read the input whose corners are further apart; unbounded corners count as far apart
+			spreadX = spread_( n[0], m[0], n[2], m[2] );
+			spreadY = spread_( n[0], m[0], n[1], m[1] );
+			return false;
+		}
+
+		// Distance between the floors of two corners, saturated at LLONG_MAX; LLONG_MAX if either is unbounded
+		static long long spread_( const Wide &n1, const Wide &m1, const Wide &n2, const Wide &m2 )
+		{
+			Wide q1, q2, s;
+			if ( m1 == 0 || m2 == 0 || floorDiv_( n1, m1, q1 ) != FRACTION_OK || floorDiv_( n2, m2, q2 ) != FRACTION_OK )
+				return LLONG_MAX;
+			if ( q1 < q2 ) std::swap( q1, q2 );
+			if ( subOverflow_( q1, q2, s ) || s > LLONG_MAX ) return LLONG_MAX;
+			return (long long)s;
+		}
+
+		// z = r + 1 / z'
+		void emit_( const Wide &r )
+		{
+			Wide na, nb, nc, nd;
+			Fraction::throwIfError( mulAdd_( -r, e, a, na ) );
+			Fraction::throwIfError( mulAdd_( -r, f, b, nb ) );
+			Fraction::throwIfError( mulAdd_( -r, g, c, nc ) );
+			Fraction::throwIfError( mulAdd_( -r, h, d, nd ) );
+			a = e; b = f; c = g; d = h;
+			e = na; f = nb; g = nc; h = nd;
+		}
+
+		// x = p + 1 / x', or x' infinite at the end of x
+		void readX_()
+		{
+			long long p;
+			if ( !x->term( nextX, p ) )
+			{
+				c = a; d = b; g = e; h = f;
+				doneX = true;
+				return;
+			}
+
+			Wide na, nb, ne, nf;
+			Fraction::throwIfError( mulAdd_( a, p, c, na ) );
+			Fraction::throwIfError( mulAdd_( b, p, d, nb ) );
+			Fraction::throwIfError( mulAdd_( e, p, g, ne ) );
+			Fraction::throwIfError( mulAdd_( f, p, h, nf ) );
+			c = a; d = b; g = e; h = f;
+			a = na; b = nb; e = ne; f = nf;
+			nextX++;
+		}
+
+		// y = q + 1 / y', or y' infinite at the end of y
+		void readY_()
+		{
+			long long q;
+			if ( !y->term( nextY, q ) )
+			{
+				b = a; d = c; f = e; h = g;
+				doneY = true;
+				return;
+			}
+
+			Wide na, nc, ne, ng;
+			Fraction::throwIfError( mulAdd_( a, q, b, na ) );
+			Fraction::throwIfError( mulAdd_( c, q, d, nc ) );
+			Fraction::throwIfError( mulAdd_( e, q, f, ne ) );
+			Fraction::throwIfError( mulAdd_( g, q, h, ng ) );
+			b = a; d = c; f = e; h = g;
+			a = na; c = nc; e = ne; g = ng;
+			nextY++;
+		}
+	};
+
+	std::shared_ptr<Source> source;
+
+	explicit ContinuedFraction( const std::shared_ptr<Source> &s ) : source( s ) {}
+
+	static Source *fromDouble_( const double &value )
+	{
+		if ( !std::isfinite( value ) ) Fraction::throwIfError( FRACTION_OVERFLOW );
+		if ( value == 0 ) return new Euclid( 0, 1 );
+
+		// value = mantissa * 2 ^ exponent, with a 53-bit integer mantissa
+		int exponent;
+		double fraction = std::frexp( value, &exponent );
+		long long mantissa = (long long)std::ldexp( fraction, 53 );
+		exponent -= 53;
+		while ( mantissa % 2 == 0 && exponent < 0 )
+		{
+			mantissa /= 2;
+			exponent++;
+		}
+
+		if ( exponent >= 0 )
+		{
+			if ( std::fabs( value ) >= std::ldexp( 1.0, 63 ) ) Fraction::throwIfError( FRACTION_OVERFLOW );
+			return new Euclid( (long long)value, 1 );
+		}
+		if ( -exponent > (int)( sizeof( Wide ) * CHAR_BIT ) - 2 ) Fraction::throwIfError( FRACTION_OVERFLOW );
+		return new Euclid( mantissa, (Wide)1 << -exponent );
+	}
+
+/*====================================	UTILITIES ======================================================
+ *======================================================================================================*/
+
+	// out = a op b; return true if the result does not fit in Wide
+	static bool addOverflow_( const Wide &a, const Wide &b, Wide &out ) noexcept
+	{
+#if defined(__GNUC__)
+		return __builtin_add_overflow( a, b, &out );
+#else
+		return Fraction::checkedAdd( a, b, out ) != FRACTION_OK;  // Wide is long long here
+#endif
+	}
+
+	static bool subOverflow_( const Wide &a, const Wide &b, Wide &out ) noexcept
+	{
+#if defined(__GNUC__)
+		return __builtin_sub_overflow( a, b, &out );
+#else
+		return Fraction::checkedSub( a, b, out ) != FRACTION_OK;
+#endif
+	}
+
+	static bool mulOverflow_( const Wide &a, const Wide &b, Wide &out ) noexcept
+	{
+#if defined(__GNUC__)
+		return __builtin_mul_overflow( a, b, &out );
+#else
+		return Fraction::checkedMul( a, b, out ) != FRACTION_OK;
+#endif
+	}
+
+	// out = a * b + c
+	static FractionStatus mulAdd_( const Wide &a, const Wide &b, const Wide &c, Wide &out ) noexcept
+	{
+		Wide product;
+		if ( mulOverflow_( a, b, product ) || addOverflow_( product, c, out ) ) return FRACTION_OVERFLOW;
+		return FRACTION_OK;
+	}
+
+	// q = floor( n / m ), m != 0
+	static FractionStatus floorDiv_( const Wide &n, const Wide &m, Wide &q ) noexcept
+	{
+		if ( m == -1 ) return subOverflow_( 0, n, q ) ? FRACTION_OVERFLOW : FRACTION_OK;
+		q = n / m;
+		if ( n % m != 0 && ( ( n < 0 ) != ( m < 0 ) ) ) q--;
+		return FRACTION_OK;
+	}
+
+	// A term or an integer part as long long
+	// Throws overflow_error exception if it does not fit
+	static long long narrow_( const Wide &w )
+	{
+		if ( w > LLONG_MAX || w < LLONG_MIN ) Fraction::throwIfError( FRACTION_OVERFLOW );
+		return (long long)w;
+	}
+
+	// The floor of z = ( a x + b ) / ( c x + d ) over x in [1, infinity], if it is the same at both ends
+	static bool homographicFloor_( const Wide &a, const Wide &b, const Wide &c, const Wide &d,
+	                               const bool &started, Wide &r )
+	{
+		if ( !started ) return false;
+
+		Wide n, m;
+		if ( addOverflow_( a, b, n ) || addOverflow_( c, d, m ) ) Fraction::throwIfError( FRACTION_OVERFLOW );
+		if ( c == 0 || m == 0 || ( c < 0 ) != ( m < 0 ) ) return false;
+
+		Wide q1, q2;
+		Fraction::throwIfError( floorDiv_( a, c, q1 ) );
+		Fraction::throwIfError( floorDiv_( n, m, q2 ) );
+		if ( q1 != q2 ) return false;
+		r = q1;
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,17 @@
+//compiled part of the fraction library
+
+
+/* Built as the fraction library with FRACTION_SEPARATE_COMPILATION defined: the cold members of Fraction
+ * and the stream operators are compiled here once, instead of inline in every translation unit. */
+
+#if !defined(FRACTION_SEPARATE_COMPILATION)
+#define FRACTION_SEPARATE_COMPILATION
+#endif
+
+#include "FractionCore.ipp"
+#include "FractionIO.ipp"
+#include "FractionHash.h"
+
+// The hash tables behind FractionSet and FractionInterner
+template class FractionMap<unsigned char>;
+template class FractionMap<unsigned int>;
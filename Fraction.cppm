@@ -0,0 +1,31 @@
+//C++20 module interface for the fraction class
+
+
+/* import fraction; gives Fraction, FractionStatus and the stream operators without textual inclusion.
+ * The standard headers are included in the global module fragment; the fraction headers are included in
+ * the module itself with FRACTION_EXPORT set to export, so that their declarations are exported. The
+ * module is self-contained: it is built header-only, without FRACTION_SEPARATE_COMPILATION. */
+
+module;
+
+#include <string>
+#include <exception>
+#include <stdexcept>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <iosfwd>
+#include <istream>
+#include <ostream>
+#include <limits>
+
+#include "FractionInstrumentation.h"
+
+export module fraction;
+
+#define FRACTION_EXPORT export
+
+#include "FractionCore.h"
+#include "FractionIO.h"
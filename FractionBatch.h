@@ -0,0 +1,251 @@
+//batch kernels for columns of fractions sharing one factor
+
+
+#ifndef FRACTION_BATCH_H
+#define FRACTION_BATCH_H
+
+#include <cstddef>
+#include <vector>
+#include <climits>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header implements batch kernels that multiply or divide a whole column of fractions by the same
+  fraction, for example an exchange rate applied to every price in a table.
+
+  Calling .mul(...) on every element does a full multiplication followed by simplify(), which costs a
+  chain of hardware divisions per element. Because the factor p / q is the same for the whole batch,
+  the kernels instead:
+	-- precompute libdivide-style magic multipliers for p and q once, so that the first (and most
+	   expensive) step of each gcd is a multiply and a shift instead of a division
+	-- cross-cancel gcd( a, q ) and gcd( b, p ) for every element a / b, which leaves the product
+	   already in lowest terms so that no final simplify() is needed
+	-- finish each gcd with a binary gcd, which uses no division at all
+
+  The elements are assumed to be in lowest terms, as every arithmetic member of Fraction leaves them.
+  A negative denominator (which setDenominator() can produce) is handled.
+ */
+
+
+
+/*====================================	INVARIANT DIVISOR ==============================================
+ *======================================================================================================*/
+
+/* Divides unsigned 64-bit integers by a divisor fixed at construction, using a multiply-high and a
+ * shift (the "round up" method of libdivide). Falls back to hardware division when the compiler
+ * provides no 128-bit integer type. */
+class FractionDivider
+{
+public:
+
+	FractionDivider( const unsigned long long &d = 1 )
+	{
+		set( d );
+	}
+
+	// Set the divisor and compute its magic number
+	void set( const unsigned long long &d )
+	{
+		if ( d == 0 ) Fraction::throwIfError( FRACTION_ZERO_DENOMINATOR );
+
+		divisor = d;
+		magic = 0;
+		more = 0;
+
+#ifdef __SIZEOF_INT128__
+		int floorLog2 = 63 - __builtin_clzll( d );
+
+		// powers of two are a plain shift
+		if ( ( d & ( d - 1 ) ) == 0 )
+		{
+			more = floorLog2;
+			return;
+		}
+
+		FractionUInt128 power = (FractionUInt128)1 << ( 64 + floorLog2 );
+		unsigned long long proposed = (unsigned long long)( power / d );
+		unsigned long long rem = (unsigned long long)( power - (FractionUInt128)proposed * d );
+
+		if ( d - rem < ( 1ULL << floorLog2 ) )
+		{
+			more = floorLog2;
+		}
+		else
+		{
+			// the magic number needs 65 bits: keep the low 64 and add the dividend back in quotient()
+			proposed += proposed;
+			unsigned long long twiceRem = rem + rem;
+			if ( twiceRem >= d || twiceRem < rem ) proposed += 1;
+			more = floorLog2 | ADD_MARKER;
+		}
+		magic = proposed + 1;
+#endif
+	}
+
+	unsigned long long getDivisor() const
+	{
+		return divisor;
+	}
+
+	// Returns n / divisor
+	unsigned long long quotient( const unsigned long long &n ) const
+	{
+#ifdef __SIZEOF_INT128__
+		if ( magic == 0 ) return n >> more;
+
+		unsigned long long q = (unsigned long long)( ( (FractionUInt128)magic * n ) >> 64 );
+		if ( more & ADD_MARKER )
+			return ( ( ( n - q ) >> 1 ) + q ) >> ( more & SHIFT_MASK );
+		return q >> more;
+#else
+		return n / divisor;
+#endif
+	}
+
+	// Returns n % divisor
+	unsigned long long remainder( const unsigned long long &n ) const
+	{
+		return n - quotient( n ) * divisor;
+	}
+
+	// Returns gcd( n, divisor ). The first reduction uses the magic number, the rest is a binary gcd.
+	unsigned long long gcd( const unsigned long long &n ) const
+	{
+		if ( divisor == 1 ) return 1;
+		return Fraction::binaryGcd( divisor, remainder( n ) );
+	}
+
+private:
+
+	static const int ADD_MARKER = 0x40;
+	static const int SHIFT_MASK = 0x3F;
+
+	unsigned long long divisor;
+	unsigned long long magic;
+	int more;
+};
+
+
+
+/*====================================	BATCH KERNELS ==================================================
+ *======================================================================================================*/
+
+// out = a * b; returns true if the product does not fit in 64 bits
+inline bool mulOverflow_( const unsigned long long &a, const unsigned long long &b, unsigned long long &out )
+{
+#if defined(__GNUC__)
+	return __builtin_mul_overflow( a, b, &out );
+#else
+	out = a * b;
+	return a != 0 && out / a != b;
+#endif
+}
+
+// |n| as unsigned, defined for LLONG_MIN
+inline unsigned long long magnitude_( const long long &n )
+{
+	return n < 0 ? 0ULL - (unsigned long long)n : (unsigned long long)n;
+}
+
+/* Multiplies every element of [first, first + count) by up / uq, negated if factorNegative, where uq > 0
+ * and up / uq is in lowest terms. The magnitudes are unsigned so that a factor of 1 / LLONG_MIN can be
+ * passed. Shared implementation of scale(...) and divide(...) below. */
+inline void scaleKernel_( Fraction *first, size_t count, const bool &factorNegative, const unsigned long long &up,
+                          const unsigned long long &uq )
+{
+	if ( up == 0 )
+	{
+		for ( size_t k = 0; k < count; k++ ) first[k].set( 0, 1 );
+		return;
+	}
+
+	const FractionDivider byP( up );
+	const FractionDivider byQ( uq );
+
+	for ( size_t k = 0; k < count; k++ )
+	{
+		long long a = first[k].getNumerator();
+		long long b = first[k].getDenominator();
+
+		bool negative = ( a < 0 ) != ( b < 0 );
+		unsigned long long ua = magnitude_( a );
+		unsigned long long ub = magnitude_( b );
+		if ( factorNegative ) negative = !negative;
+
+		// cross-cancel: a / b and p / q are reduced, so (a / g1)(p / g2) / (b / g2)(q / g1) is as well
+		unsigned long long g1 = byQ.gcd( ua );
+		unsigned long long g2 = byP.gcd( ub );
+
+		unsigned long long n, d;
+		if ( mulOverflow_( g1 == 1 ? ua : ua / g1, g2 == 1 ? up : up / g2, n ) ||
+		     mulOverflow_( g2 == 1 ? ub : ub / g2, g1 == 1 ? uq : uq / g1, d ) )
+		{
+			FRACTION_COUNT( FRACTION_OVERFLOWS, 1 );
+			Fraction::throwIfError( FRACTION_OVERFLOW );
+		}
+
+		if ( n == 0 ) negative = false;
+		if ( d > (unsigned long long)LLONG_MAX || n > (unsigned long long)LLONG_MAX + ( negative ? 1 : 0 ) )
+		{
+			FRACTION_COUNT( FRACTION_OVERFLOWS, 1 );
+			Fraction::throwIfError( FRACTION_OVERFLOW );
+		}
+
+		first[k].setNumerator( negative ? (long long)( 0ULL - n ) : (long long)n );
+		first[k].setDenominator( (long long)d );
+	}
+}
+
+// Multiply every element of [first, first + count) by factor
+// Throws overflow_error exception if a result does not fit; the elements before it are already scaled
+inline void scale( Fraction *first, size_t count, const Fraction &factor )
+{
+	Fraction f( factor.getNumerator(), factor.getDenominator() ); // reduced, sign in the numerator
+	long long p = f.getNumerator();
+	scaleKernel_( first, count, p < 0, magnitude_( p ), (unsigned long long)f.getDenominator() );
+}
+
+// Divide every element of [first, first + count) by divisor
+// Throws invalid_argument exception if the divisor is 0
+// Throws overflow_error exception if a result does not fit; the elements before it are already divided
+inline void divide( Fraction *first, size_t count, const Fraction &divisor )
+{
+	Fraction f( divisor.getNumerator(), divisor.getDenominator() );
+	if ( f.getNumerator() == 0 ) Fraction::throwIfError( FRACTION_ZERO_DENOMINATOR );
+
+	long long q = f.getNumerator();
+	scaleKernel_( first, count, q < 0, (unsigned long long)f.getDenominator(), magnitude_( q ) );
+}
+
+//++++++++ Container overloads ++++++++//
+
+inline void scale( std::vector<Fraction> &values, const Fraction &factor )
+{
+	if ( !values.empty() ) scale( &values[0], values.size(), factor );
+}
+
+inline void divide( std::vector<Fraction> &values, const Fraction &divisor )
+{
+	if ( !values.empty() ) divide( &values[0], values.size(), divisor );
+}
+
+#if __cplusplus >= 202002L
+inline void scale( std::span<Fraction> values, const Fraction &factor )
+{
+	scale( values.data(), values.size(), factor );
+}
+
+inline void divide( std::span<Fraction> values, const Fraction &divisor )
+{
+	divide( values.data(), values.size(), divisor );
+}
+#endif
+
+#endif
@@ -0,0 +1,1222 @@
+//arithmetic core of the fraction class, without iostreams
+
+
+#ifndef FRACTION_CORE_H
+#define FRACTION_CORE_H
+
+#include <string>
+#include <exception>
+#include <stdexcept>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+#include "FractionInstrumentation.h"
+
+/* With FRACTION_SEPARATE_COMPILATION defined (as the fraction library target does for its users), the
+ * cold members below are only declared here and are compiled once in Fraction.cpp. Otherwise they are
+ * defined inline at the end of this header and the library is header-only. */
+#if defined(FRACTION_SEPARATE_COMPILATION)
+#define FRACTION_DECL
+#else
+#define FRACTION_DECL inline
+#endif
+
+// Fraction.cppm defines this as export when it builds the fraction module
+#if !defined(FRACTION_EXPORT)
+#define FRACTION_EXPORT
+#endif
+
+/* 128-bit integers, where the compiler has them. They are not standard C++, so they are declared once
+ * here with __extension__ (which keeps -Wpedantic quiet) and every header uses these names. */
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 FractionInt128;
+__extension__ typedef unsigned __int128 FractionUInt128;
+#endif
+
+/* Result of the status-returning (try...) members of Fraction. Those members never throw and leave
+ * the fraction unchanged unless they return FRACTION_OK. */
+FRACTION_EXPORT enum FractionStatus
+{
+	FRACTION_OK = 0,
+	FRACTION_ZERO_DENOMINATOR,      // a denominator of 0 was assigned or produced (including division by 0)
+	FRACTION_OVERFLOW,              // a result does not fit in long long
+	FRACTION_NOT_INTEGER,           // integer() of a fraction that is not a whole number
+	FRACTION_BAD_FACTOR,            // scaleUp / scaleDown factor smaller than 1
+	FRACTION_FACTOR_NOT_DIVISOR,    // scaleDown factor does not divide both numerator and denominator
+	FRACTION_BAD_STRING,            // string cannot be parsed as a fraction
+	FRACTION_EMPTY,                 // statistic (mean, minimum, ...) of too few values
+	FRACTION_SIZE_MISMATCH          // ranges that must have the same length do not
+};
+
+FRACTION_EXPORT class Fraction
+{
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+  
+  FEATURES:
+  
+  This header implements a class for representing and manipulating rational numbers.
+  It features:
+	-- Full operator overloading to allow intuitive mathematical expressions, including ^ as a power
+	   operator.
+	-- Strict denominator checking to ensure that the denominator is never 0
+	-- Fraction reduction at every step, except for in two methods scaleUp and scaleDown (should be
+	   pretty obvious that if you want to scale, you don't want to simplify...)
+	-- Construction from integers, other fractions, and strings
+	-- Member functions to check various attributes of the object
+	-- Member functions to return as integer, floating point, and string representations
+	-- If a fraction is negative, the sign is always stored in the numerator.
+	
+  ARITHMETIC AND OPERATORS
+  
+  The class is implemented such that all arithmetic member functions such as .add(...), .sub(...), etc,
+  modify the object for which they are called without returning.
+  Operators invoked do not modify the object ( except for assignment, compound assignment, and
+  increment and decrement, of course).
+  Incrementing and decrementing adds a fraction of value of 1. eg: (3 / 4)++ is 7 / 4
+  The stream extraction operator MUST read strings in the form "a / b" with the slash included. Omitting
+  the slash will result in error. This will be retinkered later. The stream operators live in
+  FractionIO.h, so that this header does not pull in iostreams.
+  The operator ^ is of lower precedence than arithmetic operators in C/C++. Therefore, to achieve PEDMAS
+  ordering, you MUST place parentheses around an expression containing a power.
+  
+  ERROR HANDLING
+  
+  Every member that can fail has a noexcept twin that returns a FractionStatus instead of throwing:
+  tryAdd, trySub, tryMul, tryDiv, tryPow, trySimplify, tryScaleUp, tryScaleDown, tryReciprocal,
+  tryIncrement, tryDecrement, tryInteger, checkedSet, checkedSetDenominator. The throwing members are
+  implemented on top of these and throw through throwIfError(...), so code built with -fno-exceptions
+  can use the try members and gets abort() instead of a throw from the others.
+  Overflow of long long is detected and reported as FRACTION_OVERFLOW (overflow_error when thrown).
+  
+  HEADERS AND LIBRARY
+  
+  This header holds the class itself and includes no iostreams and no "using namespace std". FractionIO.h
+  adds the stream operators, and Fraction.h includes both (plus the std namespace, as it always has).
+  The whole class is header-only by default. Defining FRACTION_SEPARATE_COMPILATION (done for you by
+  linking the fraction library target) moves the cold members - string parsing and formatting, error
+  messages and throwing, and the stream operators - into Fraction.cpp, which is compiled once.
+  
+  FUTURE CHANGES
+  
+  Another change is to allow for more flexible string operations; especially constructing and reading using
+  strings.
+  
+  The main change that will be implemented is to represent the fraction using arbitrary length integers, and
+  to construct using arbitrary precision floating points. This will eliminate the need to raise exceptions for
+  out of bounds integers, and will allow correct creation of a fraction from floating point numbers.
+
+ */
+
+
+
+
+
+
+/*=================================	FRIEND FUNCTIONS (MOSTLY OPERATORS) ================================
+ *======================================================================================================
+
+  These are the overloaded operator functions for a Fraction object as the RIGHT HAND operand. See the
+  section OPERATORS below for the LEFT HAND operand functions which are used to implement the following*/
+
+/*NOTE: the stream operators are declared in FractionIO.h. */
+
+//++++++++ Left-hand arithmetic operators ++++++++//
+
+	// Addition
+	friend Fraction operator+ ( const long long &num, const Fraction &frac )
+	{
+		return (frac + num);
+	}
+	
+	// Subtraction
+	friend Fraction operator- ( const long long &num, const Fraction &frac )
+	{
+		return -( frac - num );
+	}
+	
+	// Multiplication
+	friend Fraction operator* ( const long long &num, const Fraction &frac )
+	{
+		return (frac * num);
+	}
+	
+	// Division
+	friend Fraction operator/ ( const long long &num , const Fraction &frac )
+	{
+		Fraction temp = frac / num;
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.reciprocal();
+		return temp;
+	}
+	
+//++++++++ Equality Operators ++++++++//
+
+	// Is equal check: num == fraction
+	friend bool operator== ( const long long &num, const Fraction &frac )
+	{
+		return (frac == num);
+	}
+	
+	// Is not equal check: num != fraction
+	friend bool operator!= ( const long long &num, const Fraction &frac )
+	{
+		return (frac != num);
+	}
+	
+	// Is larger than: num > fraction
+	friend bool operator> ( const long long &num, const Fraction &frac )
+	{
+		return (frac < num);
+	}
+	
+	// Is lesser than: num < fraction
+	friend bool operator< ( const long long &num, const Fraction &frac )
+	{
+		return (frac > num);
+	}
+	
+	// Is larger or equal to: num >= fraction
+	friend bool operator>= ( const long long &num, const Fraction &frac )
+	{
+		return (frac <= num);
+	}
+	
+	// Is smaller or equal to: num <= fraction
+	friend bool operator<= ( const long long &num, const Fraction &frac )
+	{
+		return (frac >= num);
+	}
+	
+	
+public:
+
+/*====================================	CONSTRUCTORS  ==================================================
+ *======================================================================================================*/
+	
+	/* Default constructor: defaults to 1 / 1. Also functions as constructor from an integer,
+	 * because the denominator defaults to 1. */
+	Fraction ( const long long &n = 1, const long long &d = 1 )
+	{
+		set(n, d);
+	}
+	
+	/* Copy constructor: creates a new  from another fraction. */
+	Fraction ( const Fraction &frac )
+	{
+		set( frac );
+	}
+	
+	/* Construct using a string */
+	Fraction ( const std::string &str  )
+	{
+		set( str );
+	}
+	
+	Fraction ( const std::string &str1, const std::string &str2 )
+	{
+		set(str1, str2);
+	}
+	
+	/* NOTE: conversion from a floating point is not yet implemented owing to floating point
+	 *       representation issues. Future editions of this class will implement big integers
+	 *       and arbitrary precision floating point numbers.
+	 */
+	
+	
+/*====================================	OPERATORS ======================================================
+ *======================================================================================================*/
+ 
+/*These are the operator functions for THIS as the LEFT operand, or as the operad of a unary operator.
+ *The RIGHT operand functions are defined as FRIENDS (see above), and are implemented using the following
+ *as utilities. 
+ */
+
+//++++++++ Simple assignment ++++++++//
+
+	// Assign from another fraction
+	// The source is already a valid fraction, so this cannot fail; self-assignment does nothing
+	void operator= ( const Fraction &frac ) noexcept
+	{
+		numerator = frac.numerator;
+		denominator = frac.denominator;
+	}
+	
+	// Assign an int
+	void operator= ( const long long & num ) noexcept
+	{
+		numerator = num;
+		denominator = 1;
+	}
+ 
+//++++++++ Right-hand arithmetic operators ++++++++//
+
+	// Addition: fraction + fraction
+	Fraction operator+ ( const Fraction &frac ) const
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.add(frac);
+		return temp;
+	}
+	
+	// Addition: fraction + integer
+	Fraction operator+ ( const long long &num) const
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.add(num);
+		return temp;
+	}
+	
+	// Subtraction: fraction - fraction
+	Fraction operator- ( const Fraction &frac ) const
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.sub(frac);
+		return temp;
+	}
+	
+	// Subtraction: fraction - integer
+	Fraction operator- ( const long long &num) const                          // Fraction - long long
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.sub(num);
+		return temp;
+	}
+	
+	// Multiplication: fraction * fraction
+	Fraction operator* ( const Fraction &frac ) const                           // Fraction * Fraction
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.mul(frac);
+		return temp;
+	}
+	
+	// Multiplication: fraction * integer
+	Fraction operator* ( const long long &num) const                           // Fraction * long long
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.mul(num);
+		return temp;
+	}
+	
+	// Division: fraction / fraction
+	Fraction operator/ ( const Fraction &frac ) const       // Fraction / Fraction
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.div(frac);
+		return temp;
+	}
+	
+	// Division: fraction / integer
+	Fraction operator/ ( const long long &num ) const // Fraction / Fraction
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.div(num);
+		return temp;
+	}
+	
+	// Power: fraction ^ num
+	/* NOTE: operator^ has lower precedence than regular arithmetic operators in C++.
+	 *       ALWAYS enclose a fraction "A" in parenthesis when putting the the power of
+	 *       an integer "c" in an expression containing other operators, as in :
+				
+	 *			Wrong:  a ^ c + b  will yield a ^ (c + b)
+	 *			Right: (a ^ c) + b
+	 */
+	Fraction operator^ ( const long long &num ) const
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		temp.pow( num );
+		return temp;
+	}
+	
+//++++++++ Increment and Decrement operators ++++++++//
+
+	// Prefix increment: ++fraction
+	Fraction &operator++ ()
+	{
+		increment();
+		return *this;
+	}
+	
+	// Postfix increment: fraction++
+	Fraction operator++ ( int ) //postfix increment
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		increment();
+		return temp;
+	}
+	
+	// Prefix decrement: --fraction
+	Fraction &operator-- () // prefix decrement
+	{
+		decrement();
+		return *this;
+	}
+	
+	// Postfix decrement: fraction --
+	Fraction operator-- ( int ) //postfix decrement
+	{
+		Fraction temp( getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		decrement();
+		return temp;
+	}
+	
+	// Unary minus
+	Fraction operator- () const // unary minus
+	{
+		Fraction temp( -getNumerator(), getDenominator() );
+		FRACTION_COUNT( FRACTION_TEMPORARIES, 1 );
+		return temp;
+	}	// unary minus 
+	
+//++++++++ Left-hand equality operators ++++++++//
+
+	// Is equal check: Fraction == Fraction
+	bool operator== ( const Fraction &frac ) const
+	{
+		if ( getNumerator() == frac.getNumerator() && getDenominator() == frac.getDenominator() )
+			return true;
+		
+		return compare( frac ) == 0;
+	}
+
+	// Is equal check: Fraction == integer
+	bool operator== ( const long long &num ) const
+	{
+		if ( isInteger() )
+		{
+			if ( integer() == num ) return true;
+			else return false;
+		}
+		
+		else return false;
+	}
+	
+	// Is not equal check: fraction != fraction
+	bool operator!= ( const Fraction &frac ) const
+	{
+		return !( *this == frac );
+	}
+	
+	// Is not equal check: fraction != integer
+	bool operator!= ( const long long &num ) const 
+	{
+		if ( isInteger() )
+		{
+			if ( integer() != num ) return true;
+			else return false;
+		}
+		
+		else return true;
+	}
+	
+	// Is smaller than check: fraction < fraction
+	bool operator< (const Fraction &frac ) const
+	{
+		return compare( frac ) < 0;
+	}
+	
+	// Is smaller than check: fraction < integer
+	bool operator< (const long long &num ) const
+	{
+		return compare_( getNumerator(), getDenominator(), num, 1 ) < 0;
+	}
+	
+	// Is larger than check: fraction > fraction
+	bool operator> (const Fraction &frac ) const
+	{
+		return compare( frac ) > 0;
+	}
+	
+	// Is larger than check: fraction > integer
+	bool operator> (const long long &num ) const
+	{
+		return compare_( getNumerator(), getDenominator(), num, 1 ) > 0;
+	}
+	
+	// Is smaller than or equal to check: fraction <= fraction
+	bool operator<= (const Fraction &frac ) const
+	{
+		return compare( frac ) <= 0;
+	}
+	
+	// Is smaller than or equal to check: fraction <= integer
+	bool operator<= (const long long &num ) const
+	{
+		return compare_( getNumerator(), getDenominator(), num, 1 ) <= 0;
+	}
+	
+	// Is larger than or equal to check: fraction >= fraction
+	bool operator>= (const Fraction &frac ) const
+	{
+		return compare( frac ) >= 0;
+	}
+	
+	// Is larger than or equal to check: fraction >= integer
+	bool operator>= (const long long &num ) const
+	{
+		return compare_( getNumerator(), getDenominator(), num, 1 ) >= 0;
+	}
+
+//++++++++ Compound assignment operators ++++++++//
+
+	// Plus equals fraction
+	Fraction &operator+= ( const Fraction &frac )
+	{
+		add(frac);
+		return *this;
+	}
+	
+	// Plus equals integer
+	Fraction &operator+= ( const long long &num )
+	{
+		add(num);
+		return *this;
+	}
+	
+	// Minus equals fraction
+	Fraction &operator-= ( const Fraction &frac )
+	{
+		sub(frac);
+		return *this;
+	}
+	
+	// Minus equals integer
+	Fraction &operator-= ( const long long &num )
+	{
+		sub(num);
+		return *this;
+	}
+	
+	// Times equals fraction
+	Fraction &operator*= ( const Fraction &frac )
+	{
+		mul(frac);
+		return *this;
+	}
+	
+	// Times equals integer
+	Fraction &operator*= ( const long long &num )
+	{
+		mul(num);
+		return *this;
+	}
+	
+	// Divide equals fraction
+	Fraction &operator/= ( const Fraction &frac )
+	{
+		div(frac);
+		return *this;
+	}
+	
+	// Divicde equals integer
+	Fraction &operator/= ( const long long &num )
+	{
+		div(num);
+		return *this;
+	}
+	
+	// Power equals integer
+	Fraction &operator^= ( const long long &num )
+	{
+		pow( num );
+		return *this;
+	}
+
+
+/*====================================	SET AND GET ====================================================
+ *======================================================================================================*/
+
+// ++++++++ Set ++++++++/
+
+	// Set numerator and denominator in one go as integers
+	void set( const long long &n, const long long &d )
+	{
+		throwIfError( checkedSet( n, d ) );
+	}
+	
+	// Set using a fraction
+	void set ( const Fraction &frac )
+	{
+		set( frac.getNumerator(), frac.getDenominator() );
+	}
+	
+	// Set using 1 string
+	void set ( const std::string & str )
+	{
+		throwIfError( checkedSet( str ) );
+	}
+	
+	//set using more than one string
+	void set ( const std::string & str1, const std::string & str2 )
+	{
+		std::string result = str1 + " " + str2;
+		set( result ); // uses with 1 string defined above
+	}
+	
+	
+	// Set numerator
+	void setNumerator( const long long &n = 1) noexcept
+	{
+		numerator = n;
+	}
+	
+	// Set denominator
+	void setDenominator( const long long &d = 1)
+	{
+		throwIfError( checkedSetDenominator( d ) );
+	}
+
+//++++++++ Get ++++++++//
+
+	// Get returns a fraction
+	Fraction get() const
+	{
+		Fraction c(numerator, denominator);
+		return c;
+	}
+	
+	// getNumerator returns numerator as an integer
+	long long getNumerator() const
+	{
+		return numerator;
+	}
+	
+	// getDenominator returns denominator as an integer
+	long long getDenominator() const
+	{
+		return denominator;
+	}
+	
+	// getNumerAsFrac returns the numerator as fraction 'numerator / 1'
+	Fraction getNumerAsFrac() const
+	{
+		Fraction numer( getNumerator(), getDenominator() );
+		numer.simplify();
+		numer.setDenominator( 1 );
+		return numer;
+	}
+	
+	// getDenomAsFrac returns the denominator as fraction '1 / denominator'
+	Fraction getDenomAsFrac() const
+	{
+		Fraction denom( getNumerator() , getDenominator() );
+		denom.simplify();
+		denom.setNumerator( 1 );
+		return denom;
+	}
+	
+/*====================================	ARITHMETIC =====================================================
+ *======================================================================================================*/
+
+/*NOTE: these arithmetic methods alter the object for which they are called. */
+
+	// Add integer
+	void add( const long long &num)
+	{
+		throwIfError( tryAdd( num ) );
+	} 
+	
+	// Add Fraction
+	void add( const Fraction &frac )
+	{
+		throwIfError( tryAdd( frac ) );
+	}
+	
+	// Subtract integer
+	void sub( const long long &num)
+	{
+		throwIfError( trySub( num ) );
+	}
+	
+	// Subtract fraction
+	void sub( const Fraction &frac)
+	{
+		throwIfError( trySub( frac ) );
+	}
+	
+	// Multiply by integer
+	void mul( const long long &num)
+	{
+		throwIfError( tryMul( num ) );
+	}
+	
+	// Multiply by fraction
+	void mul( const Fraction &frac)
+	{
+		throwIfError( tryMul( frac ) );
+	}
+	
+	// Divide by integer
+	void div( const long long &num )
+	{
+		throwIfError( tryDiv( num ) );
+	}
+	
+	// Divide by fraction
+	void div( const Fraction &frac )
+	{
+		throwIfError( tryDiv( frac ) );
+	}
+	
+	// Put to the power of an integer
+	void pow( const long long &num )
+	{
+		throwIfError( tryPow( num ) );
+	}
+	
+	
+/*====================================	ARITHMETIC UTILITIES ===========================================
+ *======================================================================================================*/
+ 
+	// Simplify (reduce) the fraction
+	void simplify()
+	{
+		throwIfError( trySimplify() );
+	}
+	
+	// Scales the fraction up by an integer factor
+	// Throws invalid_argument exception if the factor is smaller than 1
+	void scaleUp(const long long &factor)
+	{
+		throwIfError( tryScaleUp( factor ) );
+	}
+	
+	// Scales the fraction down by an integer factor
+	// Throws invalid_argument exception if the factor is smaller than 1
+	// Throws invalid_argument exception if the factor does not divide both numerator and denominator
+	void scaleDown( const long long &factor )
+	{
+		throwIfError( tryScaleDown( factor ) );
+	}
+	
+	// Returns -1, 0 or 1 as the fraction is smaller than, equal to or larger than frac
+	// The comparison is exact and creates no temporaries
+	int compare( const Fraction &frac ) const noexcept
+	{
+		return compare_( getNumerator(), getDenominator(), frac.getNumerator(), frac.getDenominator() );
+	}
+	
+	// Returns the smallest common denominator that the object has with another fraction object
+	long long scd(const Fraction &other) const
+	{	
+		Fraction tempT( getNumerator() , getDenominator() );
+		Fraction tempO = other;
+		tempT.simplify();
+		tempO.simplify();
+		
+		long long thisD = tempT.getDenominator();
+		long long otherD = tempO.getDenominator();
+		
+		if( thisD == otherD) return thisD;
+		
+		else if( thisD % otherD == 0 ) return thisD;
+		else if( otherD % thisD == 0 ) return otherD;
+		else return thisD * otherD;
+	}
+	
+	// Greatest common divisor of two unsigned integers using shifts and subtractions only
+	// gcd( a, 0 ) is a
+	static unsigned long long binaryGcd( unsigned long long a, unsigned long long b )
+	{
+		FRACTION_COUNT( FRACTION_GCD_CALLS, 1 );
+		if ( a == 0 ) return b;
+		if ( b == 0 ) return a;
+
+#if defined(__GNUC__)
+		int shift = __builtin_ctzll( a | b );
+		a >>= __builtin_ctzll( a );
+		do
+		{
+			FRACTION_COUNT( FRACTION_GCD_ITERATIONS, 1 );
+			b >>= __builtin_ctzll( b );
+			if ( a > b )
+			{
+				unsigned long long t = a;
+				a = b;
+				b = t;
+			}
+			b -= a;
+		} while ( b != 0 );
+
+		return a << shift;
+#else
+		while ( b != 0 )
+		{
+			FRACTION_COUNT( FRACTION_GCD_ITERATIONS, 1 );
+			unsigned long long t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+#endif
+	}
+	
+	// Sets the fraction to its reciprocal (i.e. ( num / denom ) ^ -1 )
+	void reciprocal ()
+	{
+		throwIfError( tryReciprocal() );
+	}
+
+	void increment()
+	{
+		throwIfError( tryIncrement() );
+	}
+	void decrement()
+	{
+		throwIfError( tryDecrement() );
+	}
+	
+/*====================================	STATUS-RETURNING API ===========================================
+ *======================================================================================================*/
+
+/*NOTE: these are the noexcept counterparts of the members above. They return FRACTION_OK on success and
+ *      otherwise leave the object unchanged. */
+
+//++++++++ Set ++++++++//
+
+	// Set numerator and denominator in one go, reducing the result
+	FractionStatus checkedSet( const long long &n, const long long &d ) noexcept
+	{
+		long long rn = n, rd = d;
+		FractionStatus status = reduce_( rn, rd );
+		if ( status != FRACTION_OK ) return status;
+		
+		numerator = rn;
+		denominator = rd;
+		return FRACTION_OK;
+	}
+	
+	// Set from a string of the form "a / b", "a b" or "a"
+	FRACTION_DECL FractionStatus checkedSet( const std::string &str ) noexcept;
+	
+	// Set the denominator without reducing
+	FractionStatus checkedSetDenominator( const long long &d ) noexcept
+	{
+		if ( d == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		denominator = d;
+		return FRACTION_OK;
+	}
+
+//++++++++ Arithmetic ++++++++//
+
+	// Add integer
+	FractionStatus tryAdd( const long long &num ) noexcept
+	{
+		return assignSum_( numerator, denominator, num, 1, false );
+	}
+	
+	// Add fraction
+	FractionStatus tryAdd( const Fraction &frac ) noexcept
+	{
+		return assignSum_( numerator, denominator, frac.numerator, frac.denominator, false );
+	}
+	
+	// Subtract integer
+	FractionStatus trySub( const long long &num ) noexcept
+	{
+		return assignSum_( numerator, denominator, num, 1, true );
+	}
+	
+	// Subtract fraction
+	FractionStatus trySub( const Fraction &frac ) noexcept
+	{
+		return assignSum_( numerator, denominator, frac.numerator, frac.denominator, true );
+	}
+	
+	// Multiply by integer
+	FractionStatus tryMul( const long long &num ) noexcept
+	{
+		return assignProduct_( numerator, denominator, num, 1 );
+	}
+	
+	// Multiply by fraction
+	FractionStatus tryMul( const Fraction &frac ) noexcept
+	{
+		return assignProduct_( numerator, denominator, frac.numerator, frac.denominator );
+	}
+	
+	// Divide by integer
+	FractionStatus tryDiv( const long long &num ) noexcept
+	{
+		if ( num == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		return assignProduct_( numerator, denominator, 1, num );
+	}
+	
+	// Divide by fraction
+	FractionStatus tryDiv( const Fraction &frac ) noexcept
+	{
+		if ( frac.numerator == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		return assignProduct_( numerator, denominator, frac.denominator, frac.numerator );
+	}
+	
+	// Put to the power of an integer (by repeated squaring)
+	FractionStatus tryPow( const long long &num ) noexcept
+	{
+		if ( num == 0 )
+		{
+			numerator = 1;
+			denominator = 1;
+			return FRACTION_OK;
+		}
+		
+		unsigned long long e = num < 0 ? 0ULL - (unsigned long long)num : (unsigned long long)num;
+		long long bn = numerator, bd = denominator;
+		long long rn = 1, rd = 1;
+		
+		while ( true )
+		{
+			if ( e & 1 )
+			{
+				if ( checkedMul( rn, bn, rn ) != FRACTION_OK || checkedMul( rd, bd, rd ) != FRACTION_OK )
+					return FRACTION_OVERFLOW;
+			}
+			e >>= 1;
+			if ( e == 0 ) break;
+			if ( checkedMul( bn, bn, bn ) != FRACTION_OK || checkedMul( bd, bd, bd ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+		
+		if ( num < 0 )
+		{
+			if ( rn == 0 ) return FRACTION_ZERO_DENOMINATOR;
+			long long t = rn;
+			rn = rd;
+			rd = t;
+		}
+		
+		// keep the sign in the numerator
+		if ( rd < 0 )
+		{
+			if ( checkedSub( 0, rn, rn ) != FRACTION_OK || checkedSub( 0, rd, rd ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+		
+		numerator = rn;
+		denominator = rd;
+		return FRACTION_OK;
+	}
+	
+	// Simplify (reduce) the fraction
+	FractionStatus trySimplify() noexcept
+	{
+		return checkedSet( numerator, denominator );
+	}
+	
+	// Scale up by an integer factor (the result is reduced, as with scaleUp)
+	FractionStatus tryScaleUp( const long long &factor ) noexcept
+	{
+		if ( factor < 1 ) return FRACTION_BAD_FACTOR;
+		
+		long long n, d;
+		if ( checkedMul( factor, numerator, n ) != FRACTION_OK || checkedMul( factor, denominator, d ) != FRACTION_OK )
+			return FRACTION_OVERFLOW;
+		return checkedSet( n, d );
+	}
+	
+	// Scale down by an integer factor that divides both numerator and denominator
+	FractionStatus tryScaleDown( const long long &factor ) noexcept
+	{
+		if ( factor < 1 ) return FRACTION_BAD_FACTOR;
+		if ( numerator % factor != 0 || denominator % factor != 0 ) return FRACTION_FACTOR_NOT_DIVISOR;
+		return checkedSet( numerator / factor, denominator / factor );
+	}
+	
+	// Set to the reciprocal, without reducing; the sign stays in the numerator
+	FractionStatus tryReciprocal() noexcept
+	{
+		if ( numerator == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		
+		long long n = denominator, d = numerator;
+		if ( d < 0 )
+		{
+			if ( checkedSub( 0, n, n ) != FRACTION_OK || checkedSub( 0, d, d ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+		numerator = n;
+		denominator = d;
+		return FRACTION_OK;
+	}
+	
+	FractionStatus tryIncrement() noexcept
+	{
+		return checkedAdd( numerator, denominator, numerator );
+	}
+	
+	FractionStatus tryDecrement() noexcept
+	{
+		return checkedSub( numerator, denominator, numerator );
+	}
+	
+//++++++++ Conversion ++++++++//
+
+	// Whole number value, if the fraction is one
+	FractionStatus tryInteger( long long &out ) const noexcept
+	{
+		if ( denominator == -1 ) return checkedSub( 0, numerator, out );
+		if ( numerator % denominator != 0 ) return FRACTION_NOT_INTEGER;
+		out = numerator / denominator;
+		return FRACTION_OK;
+	}
+	
+//++++++++ Errors ++++++++//
+
+	// Throws the exception that corresponds to status, if it is not FRACTION_OK
+	// Without exception support, prints the message and aborts instead
+	static void throwIfError( const FractionStatus &status )
+	{
+		if ( status != FRACTION_OK ) raise_( status );
+	}
+	
+	FRACTION_DECL static const char *statusMessage( const FractionStatus &status ) noexcept;
+	
+/*====================================	CHECKED INTEGER UTILITIES ======================================
+ *======================================================================================================*/
+
+	// out = a + b, or FRACTION_OVERFLOW (out untouched)
+	static FractionStatus checkedAdd( const long long &a, const long long &b, long long &out ) noexcept
+	{
+#if defined(__GNUC__)
+		long long r;
+		if ( __builtin_add_overflow( a, b, &r ) ) return overflow_();
+		out = r;
+#else
+		if ( ( b > 0 && a > LLONG_MAX - b ) || ( b < 0 && a < LLONG_MIN - b ) ) return overflow_();
+		out = a + b;
+#endif
+		return FRACTION_OK;
+	}
+	
+	// out = a - b, or FRACTION_OVERFLOW (out untouched)
+	static FractionStatus checkedSub( const long long &a, const long long &b, long long &out ) noexcept
+	{
+#if defined(__GNUC__)
+		long long r;
+		if ( __builtin_sub_overflow( a, b, &r ) ) return overflow_();
+		out = r;
+#else
+		if ( ( b < 0 && a > LLONG_MAX + b ) || ( b > 0 && a < LLONG_MIN + b ) ) return overflow_();
+		out = a - b;
+#endif
+		return FRACTION_OK;
+	}
+	
+	// out = a * b, or FRACTION_OVERFLOW (out untouched)
+	static FractionStatus checkedMul( const long long &a, const long long &b, long long &out ) noexcept
+	{
+#if defined(__GNUC__)
+		long long r;
+		if ( __builtin_mul_overflow( a, b, &r ) ) return overflow_();
+		out = r;
+#else
+		if ( a > 0 )
+		{
+			if ( b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a ) return overflow_();
+		}
+		else if ( b > 0 )
+		{
+			if ( a < LLONG_MIN / b ) return overflow_();
+		}
+		else if ( a != 0 && b < LLONG_MAX / a ) return overflow_();
+		out = a * b;
+#endif
+		return FRACTION_OK;
+	}
+	
+/*====================================	MISCELLANEOUS ==================================================
+ *======================================================================================================*/
+	
+	bool isInteger() const
+	{
+		if( getNumerator() % getDenominator() == 0 ) return true;
+		else return false;
+	}
+	long long integer() const
+	{
+		long long result = 0;
+		throwIfError( tryInteger( result ) );
+		return result;
+	}
+	long double decimal() const
+	{
+		return ( long double)getNumerator() / (long double)getDenominator();
+	}
+	FRACTION_DECL std::string str() const;
+	
+private:
+
+	long long numerator;
+	long long denominator;
+
+/*====================================	PROTECTED UTILITIES ==============================================
+ *======================================================================================================*/
+
+protected:
+
+	long long gcd(long long a, long long b)
+	{
+		long long c = a % b;
+		FRACTION_COUNT( FRACTION_GCD_CALLS, 1 );
+		while(c != 0)
+		{
+			FRACTION_COUNT( FRACTION_GCD_ITERATIONS, 1 );
+			a = b;
+			b = c;
+			c = a % b;
+		}
+		return b;
+	}
+	
+	long long abs_( long long i )
+	{
+		if( i == 0 ) return 0;
+		if( i > 0 ) return i;
+		return -i;
+	}
+	
+	// Compares a / b with c / d exactly; returns -1, 0 or 1
+	static int compare_( const long long &a, const long long &b, const long long &c, const long long &d ) noexcept
+	{
+#ifdef __SIZEOF_INT128__
+		// a / b < c / d  <=>  a * d < c * b when b * d > 0, reversed otherwise
+		FractionInt128 left = (FractionInt128)a * d;
+		FractionInt128 right = (FractionInt128)c * b;
+		int result = left < right ? -1 : ( left > right ? 1 : 0 );
+		return ( b < 0 ) != ( d < 0 ) ? -result : result;
+#else
+		// compare signs first, then the magnitudes through their continued fraction expansions
+		int signA = ( a == 0 ) ? 0 : ( ( a < 0 ) != ( b < 0 ) ? -1 : 1 );
+		int signC = ( c == 0 ) ? 0 : ( ( c < 0 ) != ( d < 0 ) ? -1 : 1 );
+		if ( signA != signC ) return signA < signC ? -1 : 1;
+		if ( signA == 0 ) return 0;
+		
+		unsigned long long p = a < 0 ? 0ULL - (unsigned long long)a : (unsigned long long)a;
+		unsigned long long q = b < 0 ? 0ULL - (unsigned long long)b : (unsigned long long)b;
+		unsigned long long r = c < 0 ? 0ULL - (unsigned long long)c : (unsigned long long)c;
+		unsigned long long s = d < 0 ? 0ULL - (unsigned long long)d : (unsigned long long)d;
+		
+		// each step compares the integer parts, then the reciprocals of the remainders in reverse order
+		int result = 1;
+		while ( true )
+		{
+			unsigned long long qp = p / q, qr = r / s;
+			if ( qp != qr ) { result = qp < qr ? -result : result; break; }
+			
+			unsigned long long rp = p - qp * q, rr = r - qr * s;
+			if ( rp == 0 || rr == 0 )
+			{
+				if ( rp != rr ) result = rp == 0 ? -result : result;
+				else result = 0;
+				break;
+			}
+			
+			p = s; r = q;
+			q = rr; s = rp;
+		}
+		return signA < 0 ? -result : result;
+#endif
+	}
+	
+	// Throws (or aborts) for a status other than FRACTION_OK; kept out of line so that throwIfError stays small
+	[[noreturn]] FRACTION_DECL static void raise_( const FractionStatus &status );
+	
+	// Records an overflow detection and returns FRACTION_OVERFLOW
+	static FractionStatus overflow_() noexcept
+	{
+		FRACTION_COUNT( FRACTION_OVERFLOWS, 1 );
+		return FRACTION_OVERFLOW;
+	}
+	
+	// Reduces n / d to lowest terms with the sign in the numerator
+	static FractionStatus reduce_( long long &n, long long &d ) noexcept
+	{
+		if ( d == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		FRACTION_COUNT( FRACTION_REDUCTIONS, 1 );
+		
+		unsigned long long un = n < 0 ? 0ULL - (unsigned long long)n : (unsigned long long)n;
+		unsigned long long ud = d < 0 ? 0ULL - (unsigned long long)d : (unsigned long long)d;
+		unsigned long long g = binaryGcd( un, ud );
+		if ( g != 1 )
+		{
+			un /= g;
+			ud /= g;
+		}
+		if ( g != 1 || d < 0 ) FRACTION_COUNT( FRACTION_REDUCTIONS_CHANGED, 1 );
+		
+		bool negative = ( n < 0 ) != ( d < 0 ) && un != 0;
+		if ( ud > (unsigned long long)LLONG_MAX ) return overflow_();
+		if ( un > (unsigned long long)LLONG_MAX + ( negative ? 1 : 0 ) ) return overflow_();
+		
+		n = negative ? (long long)( 0ULL - un ) : (long long)un;
+		d = (long long)ud;
+		return FRACTION_OK;
+	}
+	
+	// Sets n / d to n / d + c / e (or - c / e), reduced. Leaves n and d unchanged on failure.
+	static FractionStatus assignSum_( long long &n, long long &d, const long long &c, const long long &e,
+	                                  const bool &subtract ) noexcept
+	{
+		// n / d + c / e = ( n * (e / g) + c * (d / g) ) / ( d * (e / g) ), with g = gcd( d, e )
+		unsigned long long ud = d < 0 ? 0ULL - (unsigned long long)d : (unsigned long long)d;
+		unsigned long long ue = e < 0 ? 0ULL - (unsigned long long)e : (unsigned long long)e;
+		long long g = (long long)binaryGcd( ud, ue );
+		
+		long long left, right, rn, rd;
+		if ( checkedMul( n, e / g, left ) != FRACTION_OK || checkedMul( c, d / g, right ) != FRACTION_OK )
+			return FRACTION_OVERFLOW;
+		if ( ( subtract ? checkedSub( left, right, rn ) : checkedAdd( left, right, rn ) ) != FRACTION_OK )
+			return FRACTION_OVERFLOW;
+		if ( checkedMul( d, e / g, rd ) != FRACTION_OK ) return FRACTION_OVERFLOW;
+		
+		FractionStatus status = reduce_( rn, rd );
+		if ( status != FRACTION_OK ) return status;
+		n = rn;
+		d = rd;
+		return FRACTION_OK;
+	}
+	
+	// Sets n / d to ( n / d ) * ( c / e ), reduced. Leaves n and d unchanged on failure.
+	static FractionStatus assignProduct_( long long &n, long long &d, const long long &c, const long long &e ) noexcept
+	{
+		if ( e == 0 ) return FRACTION_ZERO_DENOMINATOR;
+		
+		// cross-cancel first so that the products overflow as late as possible
+		unsigned long long un = n < 0 ? 0ULL - (unsigned long long)n : (unsigned long long)n;
+		unsigned long long ud = d < 0 ? 0ULL - (unsigned long long)d : (unsigned long long)d;
+		unsigned long long uc = c < 0 ? 0ULL - (unsigned long long)c : (unsigned long long)c;
+		unsigned long long ue = e < 0 ? 0ULL - (unsigned long long)e : (unsigned long long)e;
+		long long g1 = (long long)binaryGcd( un, ue );
+		long long g2 = (long long)binaryGcd( uc, ud );
+		
+		long long rn, rd;
+		if ( checkedMul( n / g1, c / g2, rn ) != FRACTION_OK || checkedMul( d / g2, e / g1, rd ) != FRACTION_OK )
+			return FRACTION_OVERFLOW;
+		
+		FractionStatus status = reduce_( rn, rd );
+		if ( status != FRACTION_OK ) return status;
+		n = rn;
+		d = rd;
+		return FRACTION_OK;
+	}
+	
+};
+
+#if !defined(FRACTION_SEPARATE_COMPILATION)
+#include "FractionCore.ipp"
+#endif
+
+#endif
@@ -0,0 +1,92 @@
+//out-of-line members of the fraction class
+
+
+#ifndef FRACTION_CORE_IPP
+#define FRACTION_CORE_IPP
+
+#include <cerrno>
+#include <cstring>
+
+#include "FractionCore.h"
+
+/* These are the members of Fraction that are rarely on a hot path. FractionCore.h includes this file
+ * (and they are inline) unless FRACTION_SEPARATE_COMPILATION is defined, in which case Fraction.cpp
+ * compiles them once. */
+
+// Set from a string of the form "a / b", "a b" or "a"
+FRACTION_DECL FractionStatus Fraction::checkedSet( const std::string &str ) noexcept
+{
+	FRACTION_COUNT( FRACTION_PARSES, 1 );
+	if ( str.empty() || str[0] == '/' || str[str.length() - 1] == '/' ) return FRACTION_BAD_STRING;
+	
+	int slash = 0;
+	for ( size_t k = 0; k < str.length() ; k++ ) if ( str[k] == '/' ) slash++;
+	if ( slash > 1 ) return FRACTION_BAD_STRING;
+	
+	// strtoll skips leading white space and accepts a sign, like reading from a stream
+	const char *begin = str.c_str();
+	char *end;
+	errno = 0;
+	long long num = std::strtoll( begin, &end, 10 );
+	if ( end == begin || errno == ERANGE ) return FRACTION_BAD_STRING;
+	
+	if ( slash == 1 ) end = std::strchr( end, '/' ) + 1;
+	
+	begin = end;
+	errno = 0;
+	long long denom = std::strtoll( begin, &end, 10 );
+	if ( errno == ERANGE ) return FRACTION_BAD_STRING;
+	if ( end == begin ) denom = 1;          // no denominator: a whole number
+	
+	return checkedSet( num, denom );
+}
+
+FRACTION_DECL std::string Fraction::str() const
+{
+	FRACTION_COUNT( FRACTION_FORMATS, 1 );
+	
+	if ( isInteger() )
+	{
+		return std::to_string( getNumerator() );
+	}
+	else {
+		return std::to_string( getNumerator() ) + " / " + std::to_string( getDenominator() );
+	}
+}
+
+FRACTION_DECL const char *Fraction::statusMessage( const FractionStatus &status ) noexcept
+{
+	switch ( status )
+	{
+		case FRACTION_OK:                 return "No error.";
+		case FRACTION_ZERO_DENOMINATOR:   return "Denominator assigned as 0.";
+		case FRACTION_OVERFLOW:           return "Result exceeds long long type limits.";
+		case FRACTION_NOT_INTEGER:        return "Fraction does NOT reduce to a whole number. Conversion would result in truncation";
+		case FRACTION_BAD_FACTOR:         return "Factor less than 1 is forbidden in functions scaleUp and scaleDown.";
+		case FRACTION_FACTOR_NOT_DIVISOR: return "Scaling factor argument does not divide both numerator and denominator.";
+		case FRACTION_BAD_STRING:         return "Cannot create a fraction from a string that is empty, begins or ends with a slash, or contains more than 1 slash.";
+		case FRACTION_EMPTY:              return "Statistic requested of too few fractions.";
+		case FRACTION_SIZE_MISMATCH:      return "Ranges of fractions that must have the same length do not.";
+	}
+	return "Unknown error.";
+}
+
+// Throws the exception that corresponds to status
+// Without exception support, prints the message and aborts instead
+FRACTION_DECL void Fraction::raise_( const FractionStatus &status )
+{
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+	switch ( status )
+	{
+		case FRACTION_OVERFLOW:    throw std::overflow_error( statusMessage( status ) );
+		case FRACTION_NOT_INTEGER: throw std::runtime_error( statusMessage( status ) );
+		default:                   throw std::invalid_argument( statusMessage( status ) );
+	}
+#else
+	std::fputs( statusMessage( status ), stderr );
+	std::fputc( '\n', stderr );
+	std::abort();
+#endif
+}
+
+#endif
@@ -0,0 +1,485 @@
+//hashing, interning and hash containers keyed by fractions
+
+
+#ifndef FRACTION_HASH_H
+#define FRACTION_HASH_H
+
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header makes fractions usable as keys in group-by and join stages.
+  It features:
+	-- FractionKey, the canonical 16-byte form of a fraction (lowest terms, positive denominator), so
+	   that equal fractions always have identical keys whatever way they were built
+	-- a std::hash specialization over the canonical form, consistent with operator==
+	-- FractionMap and FractionSet, open-addressing tables that keep each 16-byte key together with
+	   its value in one slot array, behind a separate one-byte control array: a probe scans the
+	   control bytes and reads a slot only when its hash tag matches
+	-- FractionInterner, which deduplicates fractions into dense 32-bit ids; two interned fractions
+	   are equal exactly when their ids are equal
+ */
+
+
+
+/*====================================	CANONICAL KEY ==================================================
+ *======================================================================================================*/
+
+struct FractionKey
+{
+	long long numerator;
+	long long denominator;
+
+	FractionKey() : numerator( 0 ), denominator( 1 ) {}
+
+	// Builds the canonical form: lowest terms, sign in the numerator
+	explicit FractionKey( const Fraction &frac )
+	{
+		long long n = frac.getNumerator();
+		long long d = frac.getDenominator();
+
+		unsigned long long un = n < 0 ? 0ULL - (unsigned long long)n : (unsigned long long)n;
+		unsigned long long ud = d < 0 ? 0ULL - (unsigned long long)d : (unsigned long long)d;
+
+		// every arithmetic member leaves the fraction reduced, so the gcd is almost always 1
+		unsigned long long g = Fraction::binaryGcd( un, ud );
+		if ( g != 1 )
+		{
+			un /= g;
+			ud /= g;
+		}
+
+		bool negative = ( n < 0 ) != ( d < 0 ) && un != 0;
+		numerator = negative ? (long long)( 0ULL - un ) : (long long)un;
+		denominator = (long long)ud;
+	}
+
+	Fraction get() const
+	{
+		return Fraction( numerator, denominator );
+	}
+
+	bool operator== ( const FractionKey &other ) const
+	{
+		return numerator == other.numerator && denominator == other.denominator;
+	}
+
+	bool operator!= ( const FractionKey &other ) const
+	{
+		return !( *this == other );
+	}
+
+	// 64-bit hash of the key (murmur3 finalizer over both words)
+	unsigned long long hash() const
+	{
+		unsigned long long h = (unsigned long long)numerator * 0x9E3779B97F4A7C15ULL;
+		h ^= (unsigned long long)denominator + 0x632BE59BD9B4E019ULL + ( h << 6 ) + ( h >> 2 );
+		h ^= h >> 33;
+		h *= 0xFF51AFD7ED558CCDULL;
+		h ^= h >> 33;
+		h *= 0xC4CEB9FE1A85EC53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+};
+
+namespace std
+{
+	template <> struct hash<FractionKey>
+	{
+		size_t operator() ( const FractionKey &key ) const
+		{
+			return (size_t)key.hash();
+		}
+	};
+
+	template <> struct hash<Fraction>
+	{
+		size_t operator() ( const Fraction &frac ) const
+		{
+			return (size_t)FractionKey( frac ).hash();
+		}
+	};
+}
+
+
+
+/*====================================	FRACTION MAP ===================================================
+ *======================================================================================================*/
+
+/* Open-addressing hash map from fractions to values of type T, with linear probing over a power of two
+ * number of slots. Each slot holds a key and its value, and has a control byte holding either EMPTY,
+ * DELETED, or the top 7 bits of the key's hash, so a probe only compares keys whose tag already matches.
+ * T must be default-constructible and assignable. */
+template <class T>
+class FractionMap
+{
+public:
+
+	FractionMap( size_t expected = 0 ) : count( 0 ), deleted( 0 )
+	{
+		reserve( expected );
+	}
+
+//++++++++ Lookup ++++++++//
+
+	// Returns a pointer to the value stored for frac, or NULL if there is none
+	T *find( const Fraction &frac )
+	{
+		return find( FractionKey( frac ) );
+	}
+
+	const T *find( const Fraction &frac ) const
+	{
+		return find( FractionKey( frac ) );
+	}
+
+	T *find( const FractionKey &key )
+	{
+		size_t slot = locate( key, key.hash() );
+		return slot == NOT_FOUND ? NULL : &slots[slot].value;
+	}
+
+	const T *find( const FractionKey &key ) const
+	{
+		size_t slot = locate( key, key.hash() );
+		return slot == NOT_FOUND ? NULL : &slots[slot].value;
+	}
+
+	bool contains( const Fraction &frac ) const
+	{
+		return find( frac ) != NULL;
+	}
+
+//++++++++ Modification ++++++++//
+
+	// Returns the value stored for frac, inserting a default-constructed one if there is none
+	T &operator[] ( const Fraction &frac )
+	{
+		bool inserted;
+		return slots[ insertSlot( FractionKey( frac ), inserted ) ].value;
+	}
+
+	// Inserts frac with value if it is not present. Returns true if it was inserted.
+	bool insert( const Fraction &frac, const T &value )
+	{
+		return insert( FractionKey( frac ), value );
+	}
+
+	bool insert( const FractionKey &key, const T &value )
+	{
+		bool inserted;
+		size_t slot = insertSlot( key, inserted );
+		if ( inserted ) slots[slot].value = value;
+		return inserted;
+	}
+
+	// Returns the value stored for key, inserting value first if there is none. Sets inserted to true
+	// if value was inserted.
+	T &findOrInsert( const FractionKey &key, const T &value, bool &inserted )
+	{
+		size_t slot = insertSlot( key, inserted );
+		if ( inserted ) slots[slot].value = value;
+		return slots[slot].value;
+	}
+
+	// Removes frac. Returns true if it was present.
+	bool erase( const Fraction &frac )
+	{
+		FractionKey key( frac );
+		size_t slot = locate( key, key.hash() );
+		if ( slot == NOT_FOUND ) return false;
+
+		control[slot] = DELETED;
+		slots[slot].value = T();
+		count--;
+		deleted++;
+		return true;
+	}
+
+	void clear()
+	{
+		control.assign( control.size(), EMPTY );
+		slots.assign( slots.size(), Slot() );
+		count = 0;
+		deleted = 0;
+	}
+
+	// Makes room for at least n entries without rehashing
+	void reserve( size_t n )
+	{
+		size_t wanted = MIN_CAPACITY;
+		while ( wanted - wanted / 8 < n + 1 ) wanted *= 2;
+		if ( wanted > control.size() ) rehash( wanted );
+	}
+
+//++++++++ Inspection ++++++++//
+
+	size_t size() const
+	{
+		return count;
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	// Calls fn( const Fraction &key, T &value ) for every entry, in slot order
+	template <class Fn>
+	void forEach( Fn fn )
+	{
+		for ( size_t k = 0; k < control.size(); k++ )
+			if ( isFull( control[k] ) ) fn( slots[k].key.get(), slots[k].value );
+	}
+
+	template <class Fn>
+	void forEach( Fn fn ) const
+	{
+		for ( size_t k = 0; k < control.size(); k++ )
+			if ( isFull( control[k] ) ) fn( slots[k].key.get(), slots[k].value );
+	}
+
+private:
+
+	static const unsigned char EMPTY = 0x80;
+	static const unsigned char DELETED = 0xFE;
+	static const size_t MIN_CAPACITY = 16;
+	static const size_t NOT_FOUND = (size_t)-1;
+
+	struct Slot
+	{
+		FractionKey key;
+		T value;
+
+		Slot() : key(), value() {}
+	};
+
+	std::vector<unsigned char> control;
+	std::vector<Slot> slots;
+	size_t count;
+	size_t deleted;
+
+	static bool isFull( const unsigned char &c )
+	{
+		return ( c & 0x80 ) == 0;
+	}
+
+	static unsigned char tagOf( const unsigned long long &h )
+	{
+		return (unsigned char)( h >> 57 );
+	}
+
+	// Returns the slot holding key, or NOT_FOUND
+	size_t locate( const FractionKey &key, const unsigned long long &h ) const
+	{
+		if ( control.empty() ) return NOT_FOUND;
+
+		const size_t mask = control.size() - 1;
+		const unsigned char tag = tagOf( h );
+
+		for ( size_t slot = (size_t)h & mask; ; slot = ( slot + 1 ) & mask )
+		{
+			if ( control[slot] == EMPTY ) return NOT_FOUND;
+			if ( control[slot] == tag && slots[slot].key == key ) return slot;
+		}
+	}
+
+	// Returns the slot for key, claiming a free one if the key is not present. The table only grows when
+	// a key is actually inserted, so looking up an existing key never rehashes.
+	size_t insertSlot( const FractionKey &key, bool &inserted )
+	{
+		const unsigned long long h = key.hash();
+
+		size_t found = locate( key, h );
+		if ( found != NOT_FOUND )
+		{
+			inserted = false;
+			return found;
+		}
+
+		if ( ( count + deleted + 1 ) > control.size() - control.size() / 8 )
+			rehash( count + 1 > control.size() / 2 ? control.size() * 2 : control.size() );
+
+		// the key is absent, so the first free slot on its probe sequence is the one to claim
+		const size_t mask = control.size() - 1;
+		size_t slot = (size_t)h & mask;
+		while ( isFull( control[slot] ) ) slot = ( slot + 1 ) & mask;
+
+		if ( control[slot] == DELETED ) deleted--;
+		control[slot] = tagOf( h );
+		slots[slot].key = key;
+		count++;
+		inserted = true;
+		return slot;
+	}
+
+	// Rebuilds the table with the given number of slots (a power of two), dropping tombstones
+	void rehash( size_t capacity )
+	{
+		if ( capacity < MIN_CAPACITY ) capacity = MIN_CAPACITY;
+
+		std::vector<unsigned char> oldControl( capacity, EMPTY );
+		std::vector<Slot> oldSlots( capacity );
+		oldControl.swap( control );
+		oldSlots.swap( slots );
+
+		const size_t mask = capacity - 1;
+		for ( size_t k = 0; k < oldControl.size(); k++ )
+		{
+			if ( !isFull( oldControl[k] ) ) continue;
+
+			size_t slot = (size_t)oldSlots[k].key.hash() & mask;
+			while ( control[slot] != EMPTY ) slot = ( slot + 1 ) & mask;
+
+			control[slot] = oldControl[k];
+			slots[slot] = oldSlots[k];
+		}
+		deleted = 0;
+	}
+};
+
+
+template <class T> const unsigned char FractionMap<T>::EMPTY;
+template <class T> const unsigned char FractionMap<T>::DELETED;
+template <class T> const size_t FractionMap<T>::MIN_CAPACITY;
+template <class T> const size_t FractionMap<T>::NOT_FOUND;
+
+// With the fraction library, the tables behind FractionSet and FractionInterner are compiled in Fraction.cpp
+#if defined(FRACTION_SEPARATE_COMPILATION)
+extern template class FractionMap<unsigned char>;
+extern template class FractionMap<unsigned int>;
+#endif
+
+
+/*====================================	FRACTION SET ===================================================
+ *======================================================================================================*/
+
+/* Open-addressing hash set of fractions. See FractionMap. */
+class FractionSet
+{
+public:
+
+	FractionSet( size_t expected = 0 ) : map( expected ) {}
+
+	// Returns true if frac was not already present
+	bool insert( const Fraction &frac )
+	{
+		return map.insert( frac, 1 );
+	}
+
+	bool contains( const Fraction &frac ) const
+	{
+		return map.contains( frac );
+	}
+
+	bool erase( const Fraction &frac )
+	{
+		return map.erase( frac );
+	}
+
+	void clear()
+	{
+		map.clear();
+	}
+
+	void reserve( size_t n )
+	{
+		map.reserve( n );
+	}
+
+	size_t size() const
+	{
+		return map.size();
+	}
+
+	bool empty() const
+	{
+		return map.empty();
+	}
+
+	// Calls fn( const Fraction &key ) for every element
+	template <class Fn>
+	void forEach( Fn fn ) const
+	{
+		map.forEach( ForwardKey<Fn>( fn ) );
+	}
+
+private:
+
+	template <class Fn>
+	struct ForwardKey
+	{
+		Fn fn;
+		ForwardKey( Fn f ) : fn( f ) {}
+		void operator() ( const Fraction &key, const unsigned char & ) { fn( key ); }
+	};
+
+	FractionMap<unsigned char> map;
+};
+
+
+
+/*====================================	FRACTION INTERNER ==============================================
+ *======================================================================================================*/
+
+/* Deduplicates fractions into dense 32-bit ids, assigned in order of first appearance. Comparing two
+ * ids is the same as comparing the fractions they stand for. */
+class FractionInterner
+{
+public:
+
+	FractionInterner( size_t expected = 0 ) : ids( expected )
+	{
+		fractions.reserve( expected );
+	}
+
+	// Returns the id of frac, assigning the next free id if it has not been seen
+	unsigned int intern( const Fraction &frac )
+	{
+		FractionKey key( frac );
+		bool inserted;
+		unsigned int id = ids.findOrInsert( key, (unsigned int)fractions.size(), inserted );
+
+		if ( inserted ) fractions.push_back( key );
+		return id;
+	}
+
+	// Looks up the id of frac without interning it. Returns false if it has not been seen.
+	bool find( const Fraction &frac, unsigned int &id ) const
+	{
+		const unsigned int *found = ids.find( frac );
+		if ( found == NULL ) return false;
+		id = *found;
+		return true;
+	}
+
+	// Returns the fraction an id stands for, in lowest terms
+	Fraction get( const unsigned int &id ) const
+	{
+		return fractions.at( id ).get();
+	}
+
+	size_t size() const
+	{
+		return fractions.size();
+	}
+
+	void clear()
+	{
+		ids.clear();
+		fractions.clear();
+	}
+
+private:
+
+	FractionMap<unsigned int> ids;
+	std::vector<FractionKey> fractions;
+};
+
+#endif
@@ -0,0 +1,29 @@
+//stream operators for the fraction class
+
+
+#ifndef FRACTION_IO_H
+#define FRACTION_IO_H
+
+#include <iosfwd>
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header declares the stream insertion and extraction operators for Fraction. Only <iosfwd> is
+  included here; the iostream headers are included where the operators are defined (FractionIO.ipp),
+  which is compiled into the fraction library when FRACTION_SEPARATE_COMPILATION is defined.
+ */
+
+// Stream insertion
+FRACTION_EXPORT FRACTION_DECL std::ostream &operator<< ( std::ostream &output, const Fraction &frac );
+
+// Stream extraction: reads "a / b", with the slash included
+FRACTION_EXPORT FRACTION_DECL std::istream &operator>> ( std::istream &input, Fraction &frac );
+
+#if !defined(FRACTION_SEPARATE_COMPILATION)
+#include "FractionIO.ipp"
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+//definitions of the stream operators for the fraction class
+
+
+#ifndef FRACTION_IO_IPP
+#define FRACTION_IO_IPP
+
+#include <istream>
+#include <ostream>
+#include <limits>
+
+#include "FractionIO.h"
+
+// Stream insertion
+FRACTION_DECL std::ostream &operator<< ( std::ostream &output, const Fraction &frac )
+{
+	output << frac.str();
+	return output;
+}
+
+// Stream extraction
+FRACTION_DECL std::istream &operator>> ( std::istream &input, Fraction &frac )
+{
+	long long n, d;
+	input >> n;
+	input.ignore ( std::numeric_limits<std::streamsize>::max() , '/' );
+	input >> d;
+	frac.set( n, d );
+	return input;
+}
+
+#endif
@@ -0,0 +1,202 @@
+//compile-time instrumentation counters for the fraction class
+
+
+#ifndef FRACTION_INSTRUMENTATION_H
+#define FRACTION_INSTRUMENTATION_H
+
+#include <cstddef>
+
+#ifdef FRACTION_INSTRUMENTATION
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#endif
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header counts where Fraction spends its time: gcd calls and iterations, reductions and how many
+  of them changed the fraction, overflow detections, string parses and formats, and temporaries created
+  by the operators.
+
+  Counting is compiled in only when FRACTION_INSTRUMENTATION is defined (before including any Fraction
+  header, e.g. with -DFRACTION_INSTRUMENTATION). Otherwise FRACTION_COUNT expands to nothing, no counter
+  storage exists, and snapshot() returns zeros.
+
+  Each thread increments its own counters without any locked instruction. snapshot() adds up the
+  counters of all live threads plus those of threads that have exited. reset() does not touch the
+  per-thread counters; it records the current totals as a baseline that later snapshots subtract.
+ */
+
+enum FractionCounter
+{
+	FRACTION_GCD_CALLS = 0,
+	FRACTION_GCD_ITERATIONS,
+	FRACTION_REDUCTIONS,            // reductions to lowest terms (simplify() and every arithmetic step)
+	FRACTION_REDUCTIONS_CHANGED,    // reductions that changed the numerator or denominator
+	FRACTION_OVERFLOWS,             // long long overflows detected
+	FRACTION_PARSES,                // fractions read from strings
+	FRACTION_FORMATS,               // fractions formatted as strings
+	FRACTION_TEMPORARIES,           // temporaries created by operators
+	FRACTION_COUNTER_COUNT
+};
+
+// Totals of every counter at one point in time
+struct FractionCounters
+{
+	unsigned long long value[FRACTION_COUNTER_COUNT];
+
+	FractionCounters()
+	{
+		for ( int k = 0; k < FRACTION_COUNTER_COUNT; k++ ) value[k] = 0;
+	}
+
+	unsigned long long operator[] ( const FractionCounter &counter ) const
+	{
+		return value[counter];
+	}
+
+	static const char *name( const FractionCounter &counter )
+	{
+		switch ( counter )
+		{
+			case FRACTION_GCD_CALLS:          return "gcd calls";
+			case FRACTION_GCD_ITERATIONS:     return "gcd iterations";
+			case FRACTION_REDUCTIONS:         return "reductions";
+			case FRACTION_REDUCTIONS_CHANGED: return "reductions that changed the value";
+			case FRACTION_OVERFLOWS:          return "overflows";
+			case FRACTION_PARSES:             return "string parses";
+			case FRACTION_FORMATS:            return "string formats";
+			case FRACTION_TEMPORARIES:        return "operator temporaries";
+			default:                          return "unknown";
+		}
+	}
+};
+
+#ifdef FRACTION_INSTRUMENTATION
+#define FRACTION_COUNT( counter, n ) FractionInstrumentation::add( ( counter ), ( n ) )
+#else
+#define FRACTION_COUNT( counter, n ) ( (void)0 )
+#endif
+
+class FractionInstrumentation
+{
+public:
+
+	static bool enabled()
+	{
+#ifdef FRACTION_INSTRUMENTATION
+		return true;
+#else
+		return false;
+#endif
+	}
+
+#ifdef FRACTION_INSTRUMENTATION
+
+	// Adds n to counter for the calling thread
+	static void add( const FractionCounter &counter, const unsigned long long &n )
+	{
+		std::atomic<unsigned long long> &slot = local().value[counter];
+		slot.store( slot.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+	}
+
+	// Totals since the last reset(), over all threads
+	static FractionCounters snapshot()
+	{
+		Registry &r = registry();
+		std::lock_guard<std::mutex> guard( r.lock );
+
+		FractionCounters totals = r.current();
+		for ( int k = 0; k < FRACTION_COUNTER_COUNT; k++ ) totals.value[k] -= r.baseline.value[k];
+		return totals;
+	}
+
+	static void reset()
+	{
+		Registry &r = registry();
+		std::lock_guard<std::mutex> guard( r.lock );
+		r.baseline = r.current();
+	}
+
+private:
+
+	struct Block
+	{
+		std::atomic<unsigned long long> value[FRACTION_COUNTER_COUNT];
+
+		Block()
+		{
+			for ( int k = 0; k < FRACTION_COUNTER_COUNT; k++ ) value[k].store( 0, std::memory_order_relaxed );
+		}
+	};
+
+	struct Registry
+	{
+		std::mutex lock;
+		std::vector<Block *> live;
+		FractionCounters retired;     // totals of threads that have exited
+		FractionCounters baseline;    // totals at the last reset()
+
+		// Caller holds lock
+		FractionCounters current() const
+		{
+			FractionCounters totals = retired;
+			for ( size_t t = 0; t < live.size(); t++ )
+				for ( int k = 0; k < FRACTION_COUNTER_COUNT; k++ )
+					totals.value[k] += live[t]->value[k].load( std::memory_order_relaxed );
+			return totals;
+		}
+	};
+
+	// Registers the thread's block on first use and folds it into the retired totals on thread exit
+	struct ThreadBlock
+	{
+		Block block;
+
+		ThreadBlock()
+		{
+			Registry &r = registry();
+			std::lock_guard<std::mutex> guard( r.lock );
+			r.live.push_back( &block );
+		}
+
+		~ThreadBlock()
+		{
+			Registry &r = registry();
+			std::lock_guard<std::mutex> guard( r.lock );
+			for ( int k = 0; k < FRACTION_COUNTER_COUNT; k++ )
+				r.retired.value[k] += block.value[k].load( std::memory_order_relaxed );
+			r.live.erase( std::find( r.live.begin(), r.live.end(), &block ) );
+		}
+	};
+
+	static Registry &registry()
+	{
+		// never destroyed, so that threads exiting after static destruction can still unregister
+		static Registry *r = new Registry;
+		return *r;
+	}
+
+	static Block &local()
+	{
+		static thread_local ThreadBlock t;
+		return t.block;
+	}
+
+#else
+
+	static FractionCounters snapshot()
+	{
+		return FractionCounters();
+	}
+
+	static void reset()
+	{
+	}
+
+#endif
+};
+
+#endif
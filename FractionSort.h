@@ -0,0 +1,325 @@
+//sorting, selection and partitioning of fraction arrays
+
+
+#ifndef FRACTION_SORT_H
+#define FRACTION_SORT_H
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header sorts, ranks and partitions arrays of fractions.
+  It features:
+	-- sortFractions, which computes one approximate key per element ( numerator / denominator as a
+	   double, mapped to an unsigned integer with the same order ), radix-sorts the keys, and then runs
+	   exact comparisons only inside runs of keys close enough that rounding could have swapped them
+	-- sortFractionsParallel, which sorts chunks on several threads and merges them
+	-- nthFraction, which places the n-th smallest fraction at position n like std::nth_element
+	-- partitionFractions, which moves the fractions smaller than a pivot to the front
+
+  Each key is within a few units in the last place of the exact value, so two fractions whose keys are
+  more than KEY_TOLERANCE apart are always in key order. Only the rest go through Fraction::compare(...).
+  The results are exact; the sort is not stable.
+ */
+
+
+
+/*====================================	KEYS ===========================================================
+ *======================================================================================================*/
+
+/* An element's sort key and its position in the input */
+struct FractionSortRecord
+{
+	unsigned long long key;
+	size_t index;
+};
+
+// Keys further apart than this (in units in the last place) are always in exact order
+static const unsigned long long FRACTION_KEY_TOLERANCE = 16;
+
+// Monotone approximate key: the bits of numerator / denominator as a double, reordered so that unsigned
+// comparison of keys matches numeric comparison of the doubles
+inline unsigned long long fractionSortKey( const Fraction &frac )
+{
+	double value = (double)frac.getNumerator() / (double)frac.getDenominator();
+
+	unsigned long long bits;
+	std::memcpy( &bits, &value, sizeof bits );
+	return ( bits & 0x8000000000000000ULL ) ? ~bits : ( bits | 0x8000000000000000ULL );
+}
+
+/* Exact order on records: keys when they are far apart, Fraction::compare otherwise */
+struct FractionRecordLess
+{
+	const Fraction *base;
+
+	FractionRecordLess( const Fraction *b ) : base( b ) {}
+
+	bool operator() ( const FractionSortRecord &x, const FractionSortRecord &y ) const
+	{
+		if ( x.key + FRACTION_KEY_TOLERANCE < y.key ) return true;
+		if ( y.key + FRACTION_KEY_TOLERANCE < x.key ) return false;
+		return base[x.index].compare( base[y.index] ) < 0;
+	}
+};
+
+
+
+/*====================================	UTILITIES ======================================================
+ *======================================================================================================*/
+
+inline void buildSortRecords_( const Fraction *first, size_t begin, size_t end, FractionSortRecord *records )
+{
+	for ( size_t k = begin; k < end; k++ )
+	{
+		records[k].key = fractionSortKey( first[k] );
+		records[k].index = k;
+	}
+}
+
+// LSD radix sort of records by key, 11 bits per pass. Passes where every key has the same digit are
+// skipped. tmp must hold count records.
+inline void radixSortRecords_( FractionSortRecord *records, FractionSortRecord *tmp, size_t count )
+{
+	const int BITS = 11;
+	const int PASSES = 6;
+	const size_t BUCKETS = (size_t)1 << BITS;
+
+	std::vector<size_t> histogram( PASSES * BUCKETS, 0 );
+	for ( size_t k = 0; k < count; k++ )
+		for ( int pass = 0; pass < PASSES; pass++ )
+			histogram[ pass * BUCKETS + ( ( records[k].key >> ( pass * BITS ) ) & ( BUCKETS - 1 ) ) ]++;
+
+	FractionSortRecord *from = records;
+	FractionSortRecord *to = tmp;
+
+	for ( int pass = 0; pass < PASSES; pass++ )
+	{
+		size_t *bucket = &histogram[ pass * BUCKETS ];
+		if ( bucket[ ( from[0].key >> ( pass * BITS ) ) & ( BUCKETS - 1 ) ] == count ) continue;
+
+		size_t offset = 0;
+		for ( size_t b = 0; b < BUCKETS; b++ )
+		{
+			size_t n = bucket[b];
+			bucket[b] = offset;
+			offset += n;
+		}
+
+		for ( size_t k = 0; k < count; k++ )
+			to[ bucket[ ( from[k].key >> ( pass * BITS ) ) & ( BUCKETS - 1 ) ]++ ] = from[k];
+
+		std::swap( from, to );
+	}
+
+	if ( from != records ) std::copy( from, from + count, records );
+}
+
+// After sorting by key, sorts exactly every run of consecutive records whose keys are within the
+// tolerance of their neighbours
+inline void fixUpSortRecords_( FractionSortRecord *records, size_t count, const Fraction *base )
+{
+	size_t start = 0;
+	for ( size_t k = 1; k <= count; k++ )
+	{
+		if ( k < count && records[k].key - records[k - 1].key <= FRACTION_KEY_TOLERANCE ) continue;
+
+		if ( k - start > 1 ) std::sort( records + start, records + k, FractionRecordLess( base ) );
+		start = k;
+	}
+}
+
+// Sorts records[0, count) exactly
+inline void sortRecords_( FractionSortRecord *records, FractionSortRecord *tmp, size_t count, const Fraction *base )
+{
+	if ( count < 64 )
+	{
+		std::sort( records, records + count, FractionRecordLess( base ) );
+		return;
+	}
+	radixSortRecords_( records, tmp, count );
+	fixUpSortRecords_( records, count, base );
+}
+
+// Rearranges first[0, count) into the order given by records
+inline void gatherSortRecords_( Fraction *first, const FractionSortRecord *records, size_t count )
+{
+	std::vector<Fraction> ordered( count );
+	for ( size_t k = 0; k < count; k++ ) ordered[k] = first[ records[k].index ];
+	for ( size_t k = 0; k < count; k++ ) first[k] = ordered[k];
+}
+
+
+
+/*====================================	SORTING ========================================================
+ *======================================================================================================*/
+
+// Sort [first, first + count) in ascending order
+inline void sortFractions( Fraction *first, size_t count )
+{
+	if ( count < 2 ) return;
+
+	std::vector<FractionSortRecord> records( count ), tmp( count );
+	buildSortRecords_( first, 0, count, &records[0] );
+	sortRecords_( &records[0], &tmp[0], count, first );
+	gatherSortRecords_( first, &records[0], count );
+}
+
+// Sort [first, first + count) in ascending order on up to threads threads (0: one per hardware thread)
+inline void sortFractionsParallel( Fraction *first, size_t count, unsigned int threads = 0 )
+{
+	if ( threads == 0 ) threads = std::thread::hardware_concurrency();
+	if ( threads > count / 4096 ) threads = (unsigned int)( count / 4096 );
+	if ( threads <= 1 )
+	{
+		sortFractions( first, count );
+		return;
+	}
+
+	std::vector<FractionSortRecord> records( count ), tmp( count );
+	std::vector<size_t> bounds( threads + 1 );
+	for ( unsigned int t = 0; t <= threads; t++ ) bounds[t] = count * t / threads;
+
+	// keys and chunk sorts
+	std::vector<std::thread> workers;
+	for ( unsigned int t = 0; t < threads; t++ )
+	{
+		workers.push_back( std::thread( [&, t]() {
+			size_t begin = bounds[t], end = bounds[t + 1];
+			buildSortRecords_( first, begin, end, &records[0] );
+			sortRecords_( &records[begin], &tmp[begin], end - begin, first );
+		} ) );
+	}
+	for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+
+	// pairwise merge rounds
+	FractionSortRecord *from = &records[0];
+	FractionSortRecord *to = &tmp[0];
+	while ( bounds.size() > 2 )
+	{
+		std::vector<size_t> merged;
+		workers.clear();
+
+		for ( size_t c = 0; c + 1 < bounds.size(); c += 2 )
+		{
+			size_t begin = bounds[c];
+			size_t middle = bounds[c + 1];
+			size_t end = c + 2 < bounds.size() ? bounds[c + 2] : middle;
+			merged.push_back( begin );
+
+			workers.push_back( std::thread( [=]() {
+				std::merge( from + begin, from + middle, from + middle, from + end, to + begin,
+				            FractionRecordLess( first ) );
+			} ) );
+		}
+		merged.push_back( count );
+
+		for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+		bounds.swap( merged );
+		std::swap( from, to );
+	}
+
+	gatherSortRecords_( first, from, count );
+}
+
+//++++++++ Container overloads ++++++++//
+
+inline void sortFractions( std::vector<Fraction> &values )
+{
+	if ( !values.empty() ) sortFractions( &values[0], values.size() );
+}
+
+inline void sortFractionsParallel( std::vector<Fraction> &values, unsigned int threads = 0 )
+{
+	if ( !values.empty() ) sortFractionsParallel( &values[0], values.size(), threads );
+}
+
+#if __cplusplus >= 202002L
+inline void sortFractions( std::span<Fraction> values )
+{
+	sortFractions( values.data(), values.size() );
+}
+
+inline void sortFractionsParallel( std::span<Fraction> values, unsigned int threads = 0 )
+{
+	sortFractionsParallel( values.data(), values.size(), threads );
+}
+#endif
+
+
+
+/*====================================	SELECTION AND PARTITIONING =====================================
+ *======================================================================================================*/
+
+/* Rearranges [first, first + count) so that the element at position n is the one that would be there
+ * if the range were sorted, with no larger element before it and no smaller one after it.
+ * Returns that element. n must be smaller than count. */
+inline Fraction nthFraction( Fraction *first, size_t count, size_t n )
+{
+	std::vector<FractionSortRecord> records( count );
+	buildSortRecords_( first, 0, count, &records[0] );
+	std::nth_element( records.begin(), records.begin() + n, records.end(), FractionRecordLess( first ) );
+	gatherSortRecords_( first, &records[0], count );
+	return first[n];
+}
+
+inline Fraction nthFraction( std::vector<Fraction> &values, size_t n )
+{
+	return nthFraction( &values[0], values.size(), n );
+}
+
+/* Moves every element smaller than pivot to the front of [first, first + count), keeping neither order.
+ * Returns the number of elements smaller than pivot. */
+inline size_t partitionFractions( Fraction *first, size_t count, const Fraction &pivot )
+{
+	const unsigned long long pivotKey = fractionSortKey( pivot );
+	size_t low = 0;
+	size_t high = count;
+
+	while ( true )
+	{
+		// advance low past elements smaller than the pivot, high past the others
+		while ( low < high )
+		{
+			unsigned long long key = fractionSortKey( first[low] );
+			bool smaller = key + FRACTION_KEY_TOLERANCE < pivotKey ||
+			               ( key <= pivotKey + FRACTION_KEY_TOLERANCE && first[low].compare( pivot ) < 0 );
+			if ( !smaller ) break;
+			low++;
+		}
+		while ( low < high )
+		{
+			unsigned long long key = fractionSortKey( first[high - 1] );
+			bool smaller = key + FRACTION_KEY_TOLERANCE < pivotKey ||
+			               ( key <= pivotKey + FRACTION_KEY_TOLERANCE && first[high - 1].compare( pivot ) < 0 );
+			if ( smaller ) break;
+			high--;
+		}
+		if ( low >= high ) return low;
+
+		Fraction temp;
+		temp = first[low];
+		first[low] = first[high - 1];
+		first[high - 1] = temp;
+		low++;
+		high--;
+	}
+}
+
+inline size_t partitionFractions( std::vector<Fraction> &values, const Fraction &pivot )
+{
+	return values.empty() ? 0 : partitionFractions( &values[0], values.size(), pivot );
+}
+
+#endif
@@ -0,0 +1,381 @@
+//exact sliding-window statistics over streams of fractions
+
+
+#ifndef FRACTION_STATISTICS_H
+#define FRACTION_STATISTICS_H
+
+#include <cstddef>
+#include <deque>
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header implements FractionWindowStats, which keeps the exact sum, mean, sum of squares, variance,
+  minimum and maximum of the last N fractions of a stream. Pushing a value (and evicting the oldest one)
+  costs O(1) instead of recomputing the window.
+
+  The sum and the sum of squares are kept as integers over one shared denominator D: the sum is
+  sumNumerator / D and the sum of squares is squareNumerator / D^2, where D is a multiple of every
+  denominator in the window. Adding or evicting a / b with b dividing D is then two multiplications and
+  two additions, with no gcd. D only grows when a value with a new denominator arrives; once per window
+  length of evictions (or on overflow) it is recomputed from the values still in the window, so that
+  denominators which have left the window stop inflating the numbers.
+
+  D^2 overflows long before D does, so the sum of squares is allowed to fail on its own: when it does not
+  fit, it is marked invalid and no longer tracked, and the sum, mean, minimum and maximum carry on. The
+  next recomputation of D tries to rebuild it; until then sumOfSquares() and the variances add up the
+  squares of the window directly.
+
+  The minimum and maximum are kept with monotonic deques, so each value is compared a constant number of
+  times on average.
+
+  All results are exact. Results that do not fit in long long throw overflow_error, like the arithmetic
+  members of Fraction; a push whose sum does not fit throws before changing the window. Statistics of an
+  empty window (or a sample variance of fewer than 2 values) throw invalid_argument.
+ */
+
+class FractionWindowStats
+{
+public:
+
+	// window is the number of most recent values kept; it must be at least 1
+	FractionWindowStats( size_t window = 1 ) : capacity( window == 0 ? 1 : window )
+	{
+		clear();
+	}
+
+//++++++++ Updates ++++++++//
+
+	// Adds frac to the window, evicting the oldest value if the window is full
+	// If the new sum does not fit, throws overflow_error exception and leaves the window unchanged
+	void push( const Fraction &frac )
+	{
+		Fraction value;
+		value.setNumerator( frac.getNumerator() );
+		value.setDenominator( frac.getDenominator() );
+		if ( value.getDenominator() < 0 ) value.set( value );     // sign into the numerator
+
+		// move the window first, then the accumulators; undo the move if they cannot follow
+		const bool full = values.size() == capacity;
+		Fraction oldest;
+		if ( full )
+		{
+			oldest = values.front();
+			values.pop_front();
+			evicted++;
+		}
+		values.push_back( value );
+
+		long long savedDenominator = denominator, savedSum = sumNumerator, savedSquare = squareNumerator;
+		bool savedSquaresValid = squaresValid;
+		FractionStatus status = FRACTION_OK;
+		if ( full ) status = accumulate_( oldest.getNumerator(), oldest.getDenominator(), true );
+		if ( status == FRACTION_OK ) status = accumulate_( value.getNumerator(), value.getDenominator(), false );
+		if ( status != FRACTION_OK )
+		{
+			denominator = savedDenominator;
+			sumNumerator = savedSum;
+			squareNumerator = savedSquare;
+			squaresValid = savedSquaresValid;
+			status = rebase_();
+		}
+		if ( status != FRACTION_OK )
+		{
+			values.pop_back();
+			if ( full )
+			{
+				values.push_front( oldest );
+				evicted--;
+			}
+			Fraction::throwIfError( status );
+		}
+
+		if ( full )
+		{
+			if ( evicted - rebased >= capacity ) rebase_();   // on failure the accumulators are still exact
+			dropEvictedExtremes_();
+		}
+
+		while ( !minimum.empty() && minimum.back().value.compare( value ) >= 0 ) minimum.pop_back();
+		minimum.push_back( Entry( value, pushed ) );
+		while ( !maximum.empty() && maximum.back().value.compare( value ) <= 0 ) maximum.pop_back();
+		maximum.push_back( Entry( value, pushed ) );
+		pushed++;
+	}
+
+	// Evicts the oldest value. Does nothing if the window is empty.
+	void pop()
+	{
+		if ( values.empty() ) return;
+
+		Fraction oldest = values.front();
+		values.pop_front();
+		evicted++;
+
+		// a failed subtraction or a full window of evictions: recompute from what is left
+		FractionStatus status = accumulate_( oldest.getNumerator(), oldest.getDenominator(), true );
+		if ( status != FRACTION_OK || evicted - rebased >= capacity )
+		{
+			FractionStatus rebaseStatus = rebase_();
+			if ( status != FRACTION_OK && rebaseStatus != FRACTION_OK )
+			{
+				values.push_front( oldest );
+				evicted--;
+				Fraction::throwIfError( rebaseStatus );
+			}
+		}
+
+		dropEvictedExtremes_();
+	}
+
+	void clear()
+	{
+		values.clear();
+		minimum.clear();
+		maximum.clear();
+		denominator = 1;
+		sumNumerator = 0;
+		squareNumerator = 0;
+		squaresValid = true;
+		pushed = 0;
+		evicted = 0;
+		rebased = 0;
+	}
+
+//++++++++ Statistics ++++++++//
+
+	size_t size() const
+	{
+		return values.size();
+	}
+
+	size_t window() const
+	{
+		return capacity;
+	}
+
+	bool empty() const
+	{
+		return values.empty();
+	}
+
+	Fraction sum() const
+	{
+		return Fraction( sumNumerator, denominator );
+	}
+
+	// Throws overflow_error exception if the sum of squares does not fit, even though the sum may
+	Fraction sumOfSquares() const
+	{
+		if ( squaresValid )
+		{
+			Fraction result( squareNumerator, denominator );
+			result.div( denominator );
+			return result;
+		}
+
+		// not tracked over D^2: add the squares up directly, reducing at every step
+		Fraction result( 0, 1 );
+		for ( size_t k = 0; k < values.size(); k++ )
+		{
+			Fraction square = values[k];
+			square.mul( values[k] );
+			result.add( square );
+		}
+		return result;
+	}
+
+	Fraction mean() const
+	{
+		requireValues_();
+		Fraction result( sumNumerator, denominator );
+		result.div( (long long)values.size() );
+		return result;
+	}
+
+	// Population variance: mean of the squares minus the square of the mean
+	Fraction variance() const
+	{
+		Fraction m = mean();
+		Fraction meanSquare = m;
+		meanSquare.mul( m );
+
+		Fraction result = sumOfSquares();
+		result.div( (long long)values.size() );
+		result.sub( meanSquare );
+		return result;
+	}
+
+	// Sample variance: population variance * n / ( n - 1 ). Needs at least 2 values.
+	Fraction sampleVariance() const
+	{
+		if ( values.size() < 2 ) Fraction::throwIfError( FRACTION_EMPTY );
+
+		Fraction result = variance();
+		result.mul( (long long)values.size() );
+		result.div( (long long)values.size() - 1 );
+		return result;
+	}
+
+	Fraction min() const
+	{
+		requireValues_();
+		return minimum.front().value;
+	}
+
+	Fraction max() const
+	{
+		requireValues_();
+		return maximum.front().value;
+	}
+
+	// Shared denominator currently used by the accumulators
+	long long sharedDenominator() const
+	{
+		return denominator;
+	}
+
+private:
+
+	struct Entry
+	{
+		Fraction value;
+		unsigned long long sequence;
+
+		Entry( const Fraction &v, const unsigned long long &s ) : value( v ), sequence( s ) {}
+	};
+
+	size_t capacity;
+	std::deque<Fraction> values;
+	std::deque<Entry> minimum;         // increasing values, the front is the window minimum
+	std::deque<Entry> maximum;         // decreasing values, the front is the window maximum
+
+	long long denominator;             // D, a multiple of every denominator in the window
+	long long sumNumerator;            // sum = sumNumerator / D
+	long long squareNumerator;         // sum of squares = squareNumerator / D^2, if squaresValid
+	bool squaresValid;                 // false once the squares overflowed, until the next rebase
+
+	unsigned long long pushed;         // sequence number of the next push
+	unsigned long long evicted;        // number of evictions so far
+	unsigned long long rebased;        // value of evicted at the last rebase
+
+	void requireValues_() const
+	{
+		if ( values.empty() ) Fraction::throwIfError( FRACTION_EMPTY );
+	}
+
+	// Drops the minimum and maximum candidates that were evicted; one eviction drops at most one of each
+	void dropEvictedExtremes_()
+	{
+		const unsigned long long oldestKept = evicted;
+		if ( !minimum.empty() && minimum.front().sequence < oldestKept ) minimum.pop_front();
+		if ( !maximum.empty() && maximum.front().sequence < oldestKept ) maximum.pop_front();
+	}
+
+	// Moves the accumulators to a shared denominator that b divides. Fails only if D or the sum overflow;
+	// if the sum of squares does, it is marked invalid instead.
+	FractionStatus cover_( const long long &b ) noexcept
+	{
+		if ( denominator % b == 0 ) return FRACTION_OK;
+
+		long long factor = b / (long long)Fraction::binaryGcd( (unsigned long long)denominator, (unsigned long long)b );
+		long long d, s;
+		if ( Fraction::checkedMul( denominator, factor, d ) != FRACTION_OK ||
+		     Fraction::checkedMul( sumNumerator, factor, s ) != FRACTION_OK )
+			return FRACTION_OVERFLOW;
+
+		if ( squaresValid && squareNumerator != 0 )
+		{
+			long long q, factorSquared;
+			if ( Fraction::checkedMul( factor, factor, factorSquared ) != FRACTION_OK ||
+			     Fraction::checkedMul( squareNumerator, factorSquared, q ) != FRACTION_OK )
+				squaresValid = false;
+			else
+				squareNumerator = q;
+		}
+
+		denominator = d;
+		sumNumerator = s;
+		return FRACTION_OK;
+	}
+
+	// Adds a / b (b > 0) to the accumulators, or removes it. Leaves them unchanged if the sum overflows;
+	// if only the sum of squares does, it is marked invalid and the update succeeds.
+	FractionStatus accumulate_( const long long &a, const long long &b, const bool &remove ) noexcept
+	{
+		long long savedDenominator = denominator, savedSum = sumNumerator, savedSquare = squareNumerator;
+		bool savedSquaresValid = squaresValid;
+
+		FractionStatus status = cover_( b );
+		if ( status != FRACTION_OK ) return status;
+
+		long long term, s;
+		if ( Fraction::checkedMul( a, denominator / b, term ) != FRACTION_OK ||
+		     ( remove ? Fraction::checkedSub( sumNumerator, term, s )
+		              : Fraction::checkedAdd( sumNumerator, term, s ) ) != FRACTION_OK )
+		{
+			denominator = savedDenominator;
+			sumNumerator = savedSum;
+			squareNumerator = savedSquare;
+			squaresValid = savedSquaresValid;
+			return FRACTION_OVERFLOW;
+		}
+
+		if ( squaresValid )
+		{
+			long long termSquared, q;
+			if ( Fraction::checkedMul( term, term, termSquared ) != FRACTION_OK ||
+			     ( remove ? Fraction::checkedSub( squareNumerator, termSquared, q )
+			              : Fraction::checkedAdd( squareNumerator, termSquared, q ) ) != FRACTION_OK )
+				squaresValid = false;
+			else
+				squareNumerator = q;
+		}
+
+		sumNumerator = s;
+		return FRACTION_OK;
+	}
+
+	// Recomputes the shared denominator and the accumulators from the values in the window, including
+	// the sum of squares if it was marked invalid
+	FractionStatus rebase_() noexcept
+	{
+		long long savedDenominator = denominator, savedSum = sumNumerator, savedSquare = squareNumerator;
+		bool savedSquaresValid = squaresValid;
+		denominator = 1;
+		sumNumerator = 0;
+		squareNumerator = 0;
+		squaresValid = true;
+
+		// the least common multiple first, so that the sums are only scaled once
+		for ( size_t k = 0; k < values.size(); k++ )
+		{
+			if ( cover_( values[k].getDenominator() ) != FRACTION_OK )
+			{
+				denominator = savedDenominator;
+				sumNumerator = savedSum;
+				squareNumerator = savedSquare;
+				squaresValid = savedSquaresValid;
+				return FRACTION_OVERFLOW;
+			}
+		}
+		for ( size_t k = 0; k < values.size(); k++ )
+		{
+			if ( accumulate_( values[k].getNumerator(), values[k].getDenominator(), false ) != FRACTION_OK )
+			{
+				denominator = savedDenominator;
+				sumNumerator = savedSum;
+				squareNumerator = savedSquare;
+				squaresValid = savedSquaresValid;
+				return FRACTION_OVERFLOW;
+			}
+		}
+
+		rebased = evicted;
+		return FRACTION_OK;
+	}
+};
+
+#endif
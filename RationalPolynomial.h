@@ -0,0 +1,305 @@
+//exact polynomials with fraction coefficients
+
+
+#ifndef RATIONAL_POLYNOMIAL_H
+#define RATIONAL_POLYNOMIAL_H
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "FractionCore.h"
+
+/*=====================================	A NOTE ABOUT THIS HEADER =======================================
+ *======================================================================================================
+
+  This header implements RationalPolynomial, a polynomial with fraction coefficients that is evaluated
+  exactly at fraction points.
+
+  The coefficients are brought to one common denominator D when the polynomial is built, so that
+  P( x ) = ( N0 + N1 x + ... + Nn x^n ) / D with integer Ni. At a point x = p / q this is
+  ( N0 q^n + N1 p q^(n-1) + ... + Nn p^n ) / ( q^n D ), which is evaluated by Horner's rule on integers
+  alone and reduced once at the end, instead of reducing after every addition and multiplication as
+  (a ^ k) * c + ... would. If an intermediate integer overflows, the evaluation falls back to Horner's
+  rule on fractions, on the coefficients in lowest terms, which reduces (and cross-cancels) at every
+  step and so keeps the numbers as small as possible.
+
+  Batches of points can be evaluated on several threads, and interpolate(...) builds the unique
+  polynomial of lowest degree through a set of points.
+ */
+
+class RationalPolynomial
+{
+public:
+
+/*====================================	CONSTRUCTORS  ==================================================
+ *======================================================================================================*/
+
+	/* Zero polynomial */
+	RationalPolynomial() : denominator( 1 ) {}
+
+	/* From coefficients, constant term first: coefficients[i] multiplies x^i
+	 * Throws overflow_error exception if the common denominator does not fit in long long */
+	RationalPolynomial( const std::vector<Fraction> &coefficients ) : denominator( 1 )
+	{
+		if ( !coefficients.empty() ) set( &coefficients[0], coefficients.size() );
+	}
+
+	RationalPolynomial( const Fraction *coefficients, size_t count ) : denominator( 1 )
+	{
+		set( coefficients, count );
+	}
+
+	void set( const Fraction *coefficients, size_t count )
+	{
+		// common denominator: least common multiple of the coefficient denominators
+		long long common = 1;
+		for ( size_t k = 0; k < count; k++ )
+		{
+			Fraction c = coefficients[k];      // reduced, positive denominator
+			long long d = c.getDenominator();
+			long long factor = d / (long long)Fraction::binaryGcd( (unsigned long long)common, (unsigned long long)d );
+			Fraction::throwIfError( Fraction::checkedMul( common, factor, common ) );
+		}
+
+		std::vector<long long> scaled( count );
+		unsigned long long content = (unsigned long long)common;
+		for ( size_t k = 0; k < count; k++ )
+		{
+			Fraction c = coefficients[k];
+			Fraction::throwIfError( Fraction::checkedMul( c.getNumerator(), common / c.getDenominator(), scaled[k] ) );
+			unsigned long long magnitude = scaled[k] < 0 ? 0ULL - (unsigned long long)scaled[k] : (unsigned long long)scaled[k];
+			content = Fraction::binaryGcd( content, magnitude );
+		}
+
+		// divide out any factor shared by every numerator and the denominator
+		if ( content > 1 )
+		{
+			common /= (long long)content;
+			for ( size_t k = 0; k < count; k++ ) scaled[k] /= (long long)content;
+		}
+
+		while ( !scaled.empty() && scaled.back() == 0 ) scaled.pop_back();
+
+		numerators.swap( scaled );
+		denominator = common;
+	}
+
+/*====================================	INSPECTION =====================================================
+ *======================================================================================================*/
+
+	// Degree of the polynomial; the zero polynomial has degree 0
+	size_t degree() const
+	{
+		return numerators.empty() ? 0 : numerators.size() - 1;
+	}
+
+	// Coefficient of x^i
+	Fraction coefficient( size_t i ) const
+	{
+		if ( i >= numerators.size() ) return Fraction( 0, 1 );
+		return Fraction( numerators[i], denominator );
+	}
+
+	std::vector<Fraction> coefficients() const
+	{
+		std::vector<Fraction> result;
+		for ( size_t k = 0; k < numerators.size(); k++ ) result.push_back( coefficient( k ) );
+		return result;
+	}
+
+	// D, the common denominator of the coefficients
+	long long commonDenominator() const
+	{
+		return denominator;
+	}
+
+/*====================================	EVALUATION =====================================================
+ *======================================================================================================*/
+
+	// Value at x
+	// Throws overflow_error exception if the value (or every way of computing it) overflows long long
+	Fraction evaluate( const Fraction &x ) const
+	{
+		Fraction result;
+		Fraction::throwIfError( tryEvaluate( x, result ) );
+		return result;
+	}
+
+	// Value at x, without throwing. result is only written on success.
+	FractionStatus tryEvaluate( const Fraction &x, Fraction &result ) const noexcept
+	{
+		if ( numerators.empty() )
+		{
+			result = 0LL;
+			return FRACTION_OK;
+		}
+
+		long long p = x.getNumerator();
+		long long q = x.getDenominator();
+		if ( q < 0 )
+		{
+			if ( Fraction::checkedSub( 0, p, p ) != FRACTION_OK || Fraction::checkedSub( 0, q, q ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+
+		if ( evaluateDelayed_( p, q, result ) == FRACTION_OK ) return FRACTION_OK;
+		return evaluateReducing_( x, result );
+	}
+
+	/* Evaluates at points[0, count) into results[0, count), on up to threads threads (0: one per hardware
+	 * thread). Throws overflow_error exception if any value overflows; results is then partly written. */
+	void evaluate( const Fraction *points, size_t count, Fraction *results, unsigned int threads = 1 ) const
+	{
+		if ( threads == 0 ) threads = std::thread::hardware_concurrency();
+		if ( threads > count / 1024 ) threads = (unsigned int)( count / 1024 );
+
+		if ( threads <= 1 )
+		{
+			Fraction::throwIfError( evaluateRange_( points, results, 0, count ) );
+			return;
+		}
+
+		std::vector<FractionStatus> status( threads, FRACTION_OK );
+		std::vector<std::thread> workers;
+		for ( unsigned int t = 0; t < threads; t++ )
+		{
+			size_t begin = count * t / threads;
+			size_t end = count * ( t + 1 ) / threads;
+			workers.push_back( std::thread( [this, &status, points, results, begin, end, t]() {
+				status[t] = evaluateRange_( points, results, begin, end );
+			} ) );
+		}
+		for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+		for ( size_t t = 0; t < status.size(); t++ ) Fraction::throwIfError( status[t] );
+	}
+
+	std::vector<Fraction> evaluate( const std::vector<Fraction> &points, unsigned int threads = 1 ) const
+	{
+		std::vector<Fraction> results( points.size() );
+		if ( !points.empty() ) evaluate( &points[0], points.size(), &results[0], threads );
+		return results;
+	}
+
+#if __cplusplus >= 202002L
+	// Throws invalid_argument exception if points and results differ in length
+	void evaluate( std::span<const Fraction> points, std::span<Fraction> results, unsigned int threads = 1 ) const
+	{
+		if ( points.size() != results.size() ) Fraction::throwIfError( FRACTION_SIZE_MISMATCH );
+		evaluate( points.data(), points.size(), results.data(), threads );
+	}
+#endif
+
+/*====================================	INTERPOLATION ==================================================
+ *======================================================================================================*/
+
+	/* The polynomial of degree at most count - 1 with P( xs[k] ) = ys[k] for every k (the Lagrange
+	 * polynomial), built from Newton's divided differences.
+	 * Throws invalid_argument exception if two xs are equal, overflow_error exception on overflow. */
+	static RationalPolynomial interpolate( const Fraction *xs, const Fraction *ys, size_t count )
+	{
+		if ( count == 0 ) return RationalPolynomial();
+
+		// divided differences, in place: after pass j, diff[k] = f[ x(k-j), ..., x(k) ]
+		std::vector<Fraction> diff( ys, ys + count );
+		for ( size_t j = 1; j < count; j++ )
+		{
+			for ( size_t k = count - 1; k >= j; k-- )
+			{
+				Fraction num = diff[k];
+				num.sub( diff[k - 1] );
+				Fraction den = xs[k];
+				den.sub( xs[k - j] );
+				num.div( den );
+				diff[k] = num;
+			}
+		}
+
+		// expand a0 + ( x - x0 )( a1 + ( x - x1 )( a2 + ... ) ) into monomial coefficients
+		std::vector<Fraction> coefficients( 1, diff[count - 1] );
+		for ( size_t k = count - 1; k-- > 0; )
+		{
+			// coefficients = coefficients * ( x - xs[k] ) + diff[k]
+			coefficients.push_back( Fraction( 0, 1 ) );
+			for ( size_t i = coefficients.size() - 1; i > 0; i-- )
+			{
+				Fraction shifted = coefficients[i];
+				shifted.mul( xs[k] );
+				coefficients[i] = coefficients[i - 1];
+				coefficients[i].sub( shifted );
+			}
+			coefficients[0].mul( xs[k] );
+			coefficients[0].mul( -1LL );
+			coefficients[0].add( diff[k] );
+		}
+
+		return RationalPolynomial( coefficients );
+	}
+
+	// Throws invalid_argument exception if xs and ys differ in length
+	static RationalPolynomial interpolate( const std::vector<Fraction> &xs, const std::vector<Fraction> &ys )
+	{
+		if ( xs.size() != ys.size() ) Fraction::throwIfError( FRACTION_SIZE_MISMATCH );
+		return xs.empty() ? RationalPolynomial() : interpolate( &xs[0], &ys[0], xs.size() );
+	}
+
+private:
+
+	std::vector<long long> numerators;     // Ni, constant term first, no trailing zeros
+	long long denominator;                 // D
+
+	// Horner's rule on integers with one reduction at the end; p / q with q > 0
+	FractionStatus evaluateDelayed_( const long long &p, const long long &q, Fraction &result ) const noexcept
+	{
+		long long acc = numerators.back();
+		long long qPower = 1;
+
+		for ( size_t k = numerators.size() - 1; k-- > 0; )
+		{
+			long long term;
+			if ( Fraction::checkedMul( qPower, q, qPower ) != FRACTION_OK ||
+			     Fraction::checkedMul( acc, p, acc ) != FRACTION_OK ||
+			     Fraction::checkedMul( numerators[k], qPower, term ) != FRACTION_OK ||
+			     Fraction::checkedAdd( acc, term, acc ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+
+		long long den;
+		if ( Fraction::checkedMul( qPower, denominator, den ) != FRACTION_OK ) return FRACTION_OVERFLOW;
+		return result.checkedSet( acc, den );
+	}
+
+	// Horner's rule on fractions, reducing at every step. Runs on the coefficients in lowest terms (Ni / D
+	// reduced one at a time), not on the Ni, which would make every intermediate D times larger.
+	FractionStatus evaluateReducing_( const Fraction &x, Fraction &result ) const noexcept
+	{
+		Fraction acc, c;
+		acc.checkedSet( numerators.back(), denominator );
+
+		for ( size_t k = numerators.size() - 1; k-- > 0; )
+		{
+			c.checkedSet( numerators[k], denominator );
+			if ( acc.tryMul( x ) != FRACTION_OK || acc.tryAdd( c ) != FRACTION_OK )
+				return FRACTION_OVERFLOW;
+		}
+
+		result = acc;
+		return FRACTION_OK;
+	}
+
+	FractionStatus evaluateRange_( const Fraction *points, Fraction *results, size_t begin, size_t end ) const noexcept
+	{
+		for ( size_t k = begin; k < end; k++ )
+		{
+			FractionStatus status = tryEvaluate( points[k], results[k] );
+			if ( status != FRACTION_OK ) return status;
+		}
+		return FRACTION_OK;
+	}
+};
+
+#endif
@@ -0,0 +1,41 @@
+//minimal checks shared by the fraction tests
+
+
+#ifndef FRACTION_TEST_H
+#define FRACTION_TEST_H
+
+#include <cstdio>
+
+/* Each test is a program that runs its checks and returns nonzero if any failed, so that CTest reports
+ * it. A failed check prints its file, line and condition and the test carries on. */
+
+static int fractionTestFailures = 0;
+
+#define CHECK( condition ) \
+	do { \
+		if ( !( condition ) ) \
+		{ \
+			std::printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); \
+			fractionTestFailures++; \
+		} \
+	} while ( 0 )
+
+// Checks that statement throws an exception of type exception
+#define CHECK_THROWS( statement, exception ) \
+	do { \
+		bool thrown = false; \
+		try { statement; } catch ( const exception & ) { thrown = true; } \
+		if ( !thrown ) \
+		{ \
+			std::printf( "%s:%d: %s did not throw %s\n", __FILE__, __LINE__, #statement, #exception ); \
+			fractionTestFailures++; \
+		} \
+	} while ( 0 )
+
+inline int fractionTestResult()
+{
+	if ( fractionTestFailures != 0 ) std::printf( "%d check(s) failed\n", fractionTestFailures );
+	return fractionTestFailures == 0 ? 0 : 1;
+}
+
+#endif
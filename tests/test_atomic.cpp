@@ -0,0 +1,74 @@
+//AtomicFraction and ShardedFractionAccumulator under concurrent updates
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "AtomicFraction.h"
+#include "FractionTest.h"
+
+static const int THREADS = 8;
+static const int UPDATES = 20000;
+
+int main()
+{
+	std::printf( "lock-free: %s\n", AtomicFraction::isLockFree() ? "yes" : "no" );
+
+	// concurrent adds and subtracts lose no update
+	AtomicFraction total( Fraction( 0, 1 ), true );
+	std::vector<std::thread> workers;
+	for ( int t = 0; t < THREADS; t++ )
+		workers.push_back( std::thread( [&total, t]() {
+			for ( int k = 0; k < UPDATES; k++ )
+			{
+				total.add( Fraction( 1, k % 4 + 1 ) );
+				if ( t % 2 == 0 ) total.sub( Fraction( 1, 6 ) );
+			}
+		} ) );
+	for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+	workers.clear();
+
+	// every thread adds UPDATES / 4 * ( 1 + 1/2 + 1/3 + 1/4 ), half of them subtract UPDATES / 6
+	Fraction expected( (long long)THREADS * UPDATES / 4 * 25, 12 );
+	expected.sub( Fraction( (long long)THREADS / 2 * UPDATES, 6 ) );
+	CHECK( total.load() == expected );
+
+	// readers never see a numerator from one store with the denominator of another
+	AtomicFraction shared( Fraction( 1, 2 ) );
+	std::atomic<bool> stop( false );
+	std::atomic<int> torn( 0 );
+	for ( int t = 0; t < THREADS / 2; t++ )
+		workers.push_back( std::thread( [&shared, &stop, &torn]() {
+			while ( !stop.load() )
+			{
+				Fraction seen = shared.load();
+				if ( seen.getDenominator() != seen.getNumerator() + 1 ) torn++;
+			}
+		} ) );
+	for ( long long k = 1; k <= 200000; k++ ) shared.store( Fraction( k * 1000003, k * 1000003 + 1 ) );
+	stop = true;
+	for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+	workers.clear();
+	CHECK( torn.load() == 0 );
+
+	// compareExchange reports the current value on failure
+	AtomicFraction cell( Fraction( 1, 3 ) );
+	Fraction guess( 1, 2 );
+	CHECK( !cell.compareExchange( guess, Fraction( 2, 3 ) ) && guess == Fraction( 1, 3 ) );
+	CHECK( cell.compareExchange( guess, Fraction( 2, 3 ) ) && cell.load() == Fraction( 2, 3 ) );
+	CHECK( cell.fetchAdd( Fraction( 1, 3 ) ) == Fraction( 2, 3 ) && cell.load() == 1 );
+
+	// the sharded accumulator, with more threads than shards
+	ShardedFractionAccumulator sharded( 3 );
+	for ( int t = 0; t < THREADS; t++ )
+		workers.push_back( std::thread( [&sharded]() {
+			for ( int k = 0; k < UPDATES; k++ ) sharded.add( Fraction( 1, k % 4 + 1 ) );
+		} ) );
+	for ( size_t t = 0; t < workers.size(); t++ ) workers[t].join();
+	CHECK( sharded.total() == Fraction( (long long)THREADS * UPDATES / 4 * 25, 12 ) );
+	sharded.reset();
+	CHECK( sharded.total() == 0 );
+
+	return fractionTestResult();
+}
@@ -0,0 +1,71 @@
+//batch kernels and the invariant divisor behind them
+
+#include <climits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "FractionBatch.h"
+#include "FractionTest.h"
+
+int main()
+{
+	std::mt19937_64 random( 26 );
+
+	// the magic numbers agree with hardware division, including divisors that need 65-bit magic numbers
+	std::vector<unsigned long long> divisors;
+	for ( unsigned long long d = 1; d < 1000; d++ ) divisors.push_back( d );
+	for ( int k = 0; k < 64; k++ ) divisors.push_back( 1ULL << k );
+	divisors.push_back( ULLONG_MAX );
+	divisors.push_back( (unsigned long long)LLONG_MAX );
+	divisors.push_back( 1ULL << 63 | 1 );
+	for ( int k = 0; k < 1000; k++ ) divisors.push_back( random() >> ( random() % 64 ) | 1 );
+
+	for ( size_t k = 0; k < divisors.size(); k++ )
+	{
+		FractionDivider divider( divisors[k] );
+		for ( int i = 0; i < 200; i++ )
+		{
+			unsigned long long n = i < 4 ? ULLONG_MAX - i : random() >> ( random() % 64 );
+			if ( divider.quotient( n ) != n / divisors[k] )
+			{
+				CHECK( divider.quotient( n ) == n / divisors[k] );
+				break;
+			}
+		}
+	}
+
+	// scale and divide match element-by-element arithmetic
+	std::vector<Fraction> values, expected;
+	for ( int k = 0; k < 5000; k++ )
+		values.push_back( Fraction( (long long)( random() % 2000001 ) - 1000000, (long long)( random() % 1000000 ) + 1 ) );
+
+	Fraction factor( -21, 10 );
+	expected = values;
+	for ( size_t k = 0; k < expected.size(); k++ ) expected[k].mul( factor );
+	scale( values, factor );
+	bool equal = true;
+	for ( size_t k = 0; k < values.size(); k++ )
+		equal = equal && values[k].getNumerator() == expected[k].getNumerator() &&
+		        values[k].getDenominator() == expected[k].getDenominator();
+	CHECK( equal );
+
+	Fraction divisor( 7, -9 );
+	for ( size_t k = 0; k < expected.size(); k++ ) expected[k].div( divisor );
+	divide( values, divisor );
+	equal = true;
+	for ( size_t k = 0; k < values.size(); k++ ) equal = equal && values[k] == expected[k];
+	CHECK( equal );
+
+	// a divisor with numerator LLONG_MIN: results that fit are exact, the others overflow
+	Fraction column[2] = { Fraction( 2, 1 ), Fraction( 0, 1 ) };
+	divide( column, 2, Fraction( LLONG_MIN, 1 ) );
+	CHECK( column[0].getNumerator() == -1 && column[0].getDenominator() == 1LL << 62 );
+	CHECK( column[1] == 0 );
+
+	Fraction third[1] = { Fraction( 1, 3 ) };
+	CHECK_THROWS( divide( third, 1, Fraction( LLONG_MIN, 1 ) ), std::overflow_error );
+	CHECK_THROWS( divide( third, 1, Fraction( 0, 1 ) ), std::invalid_argument );
+
+	return fractionTestResult();
+}
@@ -0,0 +1,58 @@
+//continued fractions and Gosper's arithmetic
+
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "ContinuedFraction.h"
+#include "FractionTest.h"
+
+int main()
+{
+	// expansions, convergents and exact values
+	ContinuedFraction x( Fraction( 415, 93 ) );
+	CHECK( x.str() == "[4; 2, 6, 7]" );
+	CHECK( x.convergent( 1 ) == Fraction( 9, 2 ) );
+	CHECK( x.value() == Fraction( 415, 93 ) );
+	CHECK( ContinuedFraction( Fraction( -7, 2 ) ).str() == "[-4; 2]" );
+	CHECK( ContinuedFraction::fromDouble( 0.375 ).value() == Fraction( 3, 8 ) );
+
+	// arithmetic matches Fraction where the exact result fits
+	ContinuedFraction y( Fraction( -17, 12 ) );
+	CHECK( ( x + y ).value() == Fraction( 415, 93 ) + Fraction( -17, 12 ) );
+	CHECK( ( x - y ).value() == Fraction( 415, 93 ) - Fraction( -17, 12 ) );
+	CHECK( ( x * y ).value() == Fraction( 415, 93 ) * Fraction( -17, 12 ) );
+	CHECK( ( x / y ).value() == Fraction( 415, 93 ) / Fraction( -17, 12 ) );
+	CHECK( ( -x ).value() == Fraction( -415, 93 ) );
+	CHECK( ( x - x ).value() == 0 );
+	CHECK_THROWS( ( x / ( y - y ) ).value(), std::invalid_argument );
+
+	// comparing long products whose exact values no longer fit in long long
+	std::mt19937_64 random( 35 );
+	bool ordered = true;
+	for ( int run = 0; run < 50; run++ )
+	{
+		ContinuedFraction p( 1LL ), q( 1LL );
+		long double approximateP = 1, approximateQ = 1;
+		for ( int k = 0; k < 12; k++ )
+		{
+			long long a = random() % 900 + 100, b = random() % 900 + 100, c = random() % 900 + 100, d = random() % 900 + 100;
+			p = p * ContinuedFraction( Fraction( a, b ) );
+			q = q * ContinuedFraction( Fraction( c, d ) );
+			approximateP *= (long double)a / b;
+			approximateQ *= (long double)c / d;
+		}
+		ordered = ordered && ( p.compare( q ) < 0 ) == ( approximateP < approximateQ );
+		ordered = ordered && p.decimal( 10 ).size() > 11;
+	}
+	CHECK( ordered );
+
+	// decimal expansion, truncated toward zero
+	CHECK( x.decimal( 5 ) == "4.46236" );
+	CHECK( ContinuedFraction( Fraction( -7, 2 ) ).decimal( 3 ) == "-3.500" );
+	CHECK( ContinuedFraction( Fraction( -1, 3 ) ).decimal( 2 ) == "-0.33" );
+	CHECK( ContinuedFraction( Fraction( -1, 3 ) ).decimal( 0 ) == "0" );
+	CHECK( ContinuedFraction( Fraction( -1, 300 ) ).decimal( 2 ) == "0.00" );
+
+	return fractionTestResult();
+}
@@ -0,0 +1,64 @@
+//the fraction class: arithmetic, status API, operators and parsing
+
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+#include "FractionCore.h"
+#include "FractionTest.h"
+
+static bool same( const Fraction &frac, const long long &n, const long long &d )
+{
+	return frac.getNumerator() == n && frac.getDenominator() == d;
+}
+
+int main()
+{
+	// arithmetic leaves fractions reduced
+	Fraction a( 1, 6 );
+	a.add( Fraction( 1, 3 ) );
+	CHECK( same( a, 1, 2 ) );
+	a.mul( Fraction( -4, 3 ) );
+	CHECK( same( a, -2, 3 ) );
+
+	// integers on the left, const operands and temporaries
+	const Fraction half( 1, 2 );
+	CHECK( 2 == Fraction( 4, 2 ) );
+	CHECK( 2 != half );
+	CHECK( 1 < Fraction( 3, 2 ) );
+	CHECK( 1 > half );
+	CHECK( ( 1 + half ) == Fraction( 3, 2 ) );
+	CHECK( ( half * half ) == Fraction( 1, 4 ) );
+
+	// compound assignments return the fraction
+	Fraction b( 1, 3 );
+	( b += Fraction( 1, 3 ) ) += Fraction( 1, 3 );
+	CHECK( b == 1 );
+
+	// the status API reports overflow and leaves the fraction unchanged
+	Fraction big( LLONG_MAX, 1 );
+	CHECK( big.tryAdd( 1LL ) == FRACTION_OVERFLOW );
+	CHECK( same( big, LLONG_MAX, 1 ) );
+	CHECK( big.tryDiv( 0LL ) == FRACTION_ZERO_DENOMINATOR );
+	CHECK_THROWS( big.add( 1LL ), std::overflow_error );
+
+	long long whole;
+	CHECK( Fraction( 6, 3 ).tryInteger( whole ) == FRACTION_OK && whole == 2 );
+	CHECK( half.tryInteger( whole ) == FRACTION_NOT_INTEGER );
+
+	// parsing
+	Fraction p;
+	CHECK( p.checkedSet( std::string( "3/4" ) ) == FRACTION_OK && same( p, 3, 4 ) );
+	CHECK( p.checkedSet( std::string( " -2 / 6" ) ) == FRACTION_OK && same( p, -1, 3 ) );
+	CHECK( p.checkedSet( std::string( "7" ) ) == FRACTION_OK && same( p, 7, 1 ) );
+	CHECK( p.checkedSet( std::string( "5 9" ) ) == FRACTION_OK && same( p, 5, 9 ) );
+	CHECK( p.checkedSet( std::string( "1/2/3" ) ) == FRACTION_BAD_STRING );
+	CHECK( p.checkedSet( std::string( "/3" ) ) == FRACTION_BAD_STRING );
+	CHECK( p.checkedSet( std::string( "99999999999999999999/2" ) ) == FRACTION_BAD_STRING );
+	CHECK( p.checkedSet( std::string( "1/99999999999999999999" ) ) == FRACTION_BAD_STRING );
+	CHECK( same( p, 5, 9 ) );
+	CHECK( Fraction( 3, 4 ).str() == "3 / 4" );
+	CHECK( Fraction( -8, 4 ).str() == "-2" );
+
+	return fractionTestResult();
+}
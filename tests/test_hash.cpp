@@ -0,0 +1,66 @@
+//hashing, hash containers and interning
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "FractionHash.h"
+#include "FractionTest.h"
+
+int main()
+{
+	// equal fractions have equal keys and hashes, whatever their form
+	Fraction unreduced( 1, 2 );
+	unreduced.setNumerator( 3 );
+	unreduced.setDenominator( -6 );
+	CHECK( FractionKey( unreduced ) == FractionKey( Fraction( -1, 2 ) ) );
+	CHECK( std::hash<Fraction>()( unreduced ) == std::hash<Fraction>()( Fraction( -1, 2 ) ) );
+
+	// FractionMap against std::map, with erasures to leave tombstones
+	std::mt19937_64 random( 27 );
+	FractionMap<long long> map;
+	std::map<std::pair<long long, long long>, long long> reference;
+	for ( int k = 0; k < 20000; k++ )
+	{
+		Fraction f( (long long)( random() % 200 ) - 100, (long long)( random() % 50 ) + 1 );
+		std::pair<long long, long long> key( f.getNumerator(), f.getDenominator() );
+		if ( random() % 4 == 0 )
+		{
+			CHECK( map.erase( f ) == ( reference.erase( key ) == 1 ) );
+		}
+		else
+		{
+			map[f] += k;
+			reference[key] += k;
+		}
+	}
+	CHECK( map.size() == reference.size() );
+	bool equal = true;
+	for ( std::map<std::pair<long long, long long>, long long>::const_iterator it = reference.begin(); it != reference.end(); ++it )
+	{
+		const long long *found = map.find( Fraction( it->first.first, it->first.second ) );
+		equal = equal && found != NULL && *found == it->second;
+	}
+	CHECK( equal );
+
+	// looking up an existing key never rehashes, even when the table is at its load limit
+	FractionMap<int> full( 0 );
+	for ( int k = 0; k < 14; k++ ) full[Fraction( k, 1 )] = k;
+	int *value = full.find( Fraction( 3, 1 ) );
+	full[Fraction( 3, 1 )] = 30;
+	CHECK( full.find( Fraction( 3, 1 ) ) == value && *value == 30 );
+
+	// FractionSet and FractionInterner
+	FractionSet set;
+	CHECK( set.insert( Fraction( 2, 4 ) ) );
+	CHECK( !set.insert( Fraction( 1, 2 ) ) );
+	CHECK( set.contains( Fraction( -3, -6 ) ) && set.size() == 1 );
+
+	FractionInterner interner;
+	unsigned int id = interner.intern( Fraction( 2, 3 ) );
+	CHECK( interner.intern( Fraction( 5, 7 ) ) != id );
+	CHECK( interner.intern( Fraction( 4, 6 ) ) == id );
+	CHECK( interner.get( id ) == Fraction( 2, 3 ) && interner.size() == 2 );
+
+	return fractionTestResult();
+}
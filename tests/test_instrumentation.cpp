@@ -0,0 +1,36 @@
+//instrumentation counters, compiled in with FRACTION_INSTRUMENTATION
+
+#include <string>
+#include <thread>
+
+#include "FractionCore.h"
+#include "FractionTest.h"
+
+int main()
+{
+	CHECK( FractionInstrumentation::enabled() );
+
+	FractionInstrumentation::reset();
+	Fraction a( 1, 2 );
+	a.add( Fraction( 1, 3 ) );
+	Fraction parsed;
+	parsed.checkedSet( std::string( "3/4" ) );
+	std::string text = parsed.str();
+
+	FractionCounters counters = FractionInstrumentation::snapshot();
+	CHECK( counters[FRACTION_REDUCTIONS] > 0 );
+	CHECK( counters[FRACTION_GCD_CALLS] > 0 );
+	CHECK( counters[FRACTION_PARSES] == 1 );
+	CHECK( counters[FRACTION_FORMATS] == 1 );
+
+	// counts from a thread that has exited are kept
+	FractionInstrumentation::reset();
+	std::thread worker( []() {
+		Fraction b;
+		b.checkedSet( std::string( "1/5" ) );
+	} );
+	worker.join();
+	CHECK( FractionInstrumentation::snapshot()[FRACTION_PARSES] == 1 );
+
+	return fractionTestResult();
+}
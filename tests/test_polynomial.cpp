@@ -0,0 +1,86 @@
+//polynomial evaluation and interpolation
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "RationalPolynomial.h"
+#include "FractionTest.h"
+
+// Horner's rule on fractions, as a reference
+static Fraction horner( const std::vector<Fraction> &coefficients, const Fraction &x )
+{
+	Fraction value( 0, 1 );
+	for ( size_t k = coefficients.size(); k-- > 0; )
+	{
+		value.mul( x );
+		value.add( coefficients[k] );
+	}
+	return value;
+}
+
+int main()
+{
+	std::mt19937_64 random( 33 );
+
+	std::vector<Fraction> coefficients;
+	coefficients.push_back( Fraction( 1, 2 ) );
+	coefficients.push_back( Fraction( -1, 3 ) );
+	coefficients.push_back( Fraction( 2, 1 ) );
+	coefficients.push_back( Fraction( 5, 12 ) );
+	RationalPolynomial p( coefficients );
+	CHECK( p.degree() == 3 && p.commonDenominator() == 12 );
+	CHECK( p.coefficient( 1 ) == Fraction( -1, 3 ) && p.coefficient( 7 ) == 0 );
+
+	// single and batch evaluation, on one and several threads
+	std::vector<Fraction> points;
+	for ( int k = 0; k < 5000; k++ )
+		points.push_back( Fraction( (long long)( random() % 2001 ) - 1000, (long long)( random() % 100 ) + 1 ) );
+
+	bool equal = true;
+	for ( size_t k = 0; k < 100; k++ ) equal = equal && p.evaluate( points[k] ) == horner( coefficients, points[k] );
+	CHECK( equal );
+
+	std::vector<Fraction> single = p.evaluate( points );
+	std::vector<Fraction> threaded = p.evaluate( points, 4 );
+	equal = true;
+	for ( size_t k = 0; k < points.size(); k++ )
+		equal = equal && single[k] == threaded[k] && single[k] == horner( coefficients, points[k] );
+	CHECK( equal );
+
+#if __cplusplus >= 202002L
+	std::vector<Fraction> results( points.size() );
+	p.evaluate( std::span<const Fraction>( points ), std::span<Fraction>( results ) );
+	CHECK( results == single );
+	std::vector<Fraction> tooShort( 1 );
+	CHECK_THROWS( p.evaluate( std::span<const Fraction>( points ), std::span<Fraction>( tooShort ) ), std::invalid_argument );
+#endif
+
+	// a point where Horner's rule on the integer numerators overflows, but the value fits: the fallback
+	// must work on the reduced coefficients, not on numerators scaled by the common denominator
+	std::vector<Fraction> wide;
+	wide.push_back( Fraction( 1, 4000000007LL ) );
+	wide.push_back( Fraction( 0, 1 ) );
+	wide.push_back( Fraction( 1, 2000000011LL ) );
+	RationalPolynomial w( wide );
+	Fraction at( 2000000011LL, 7 );
+	CHECK( w.evaluate( at ) == horner( wide, at ) );
+
+	// interpolation through points of p gives p back
+	std::vector<Fraction> xs, ys;
+	for ( long long k = 0; k < 4; k++ )
+	{
+		xs.push_back( Fraction( k * 3 - 2, k + 1 ) );
+		ys.push_back( p.evaluate( xs.back() ) );
+	}
+	RationalPolynomial q = RationalPolynomial::interpolate( xs, ys );
+	CHECK( q.coefficients() == p.coefficients() );
+
+	ys.pop_back();
+	CHECK_THROWS( RationalPolynomial::interpolate( xs, ys ), std::invalid_argument );
+	xs[1] = xs[0];
+	ys.push_back( Fraction( 1, 1 ) );
+	CHECK_THROWS( RationalPolynomial::interpolate( xs, ys ), std::invalid_argument );
+
+	return fractionTestResult();
+}
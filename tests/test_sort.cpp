@@ -0,0 +1,69 @@
+//radix sort, selection and partitioning, including values too close for their double keys
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "FractionSort.h"
+#include "FractionTest.h"
+
+static bool exactLess( const Fraction &x, const Fraction &y )
+{
+	return x.compare( y ) < 0;
+}
+
+static bool sameOrder( const std::vector<Fraction> &x, const std::vector<Fraction> &y )
+{
+	if ( x.size() != y.size() ) return false;
+	for ( size_t k = 0; k < x.size(); k++ )
+		if ( x[k].compare( y[k] ) != 0 ) return false;
+	return true;
+}
+
+int main()
+{
+	std::mt19937_64 random( 31 );
+	std::vector<Fraction> values;
+
+	for ( int k = 0; k < 20000; k++ )
+		values.push_back( Fraction( (long long)( random() % 2000001 ) - 1000000, (long long)( random() % 1000 ) + 1 ) );
+
+	// clusters whose members round to the same or neighbouring doubles, so that only the exact fix-up
+	// inside the key tolerance orders them
+	for ( int k = 0; k < 2000; k++ )
+	{
+		long long n = 1000000000000000LL + (long long)( random() % 1000 );
+		values.push_back( Fraction( n, n + 1 ) );
+		values.push_back( Fraction( -n, n + 1 ) );
+		values.push_back( Fraction( n + 1, n ) );
+	}
+	std::shuffle( values.begin(), values.end(), random );
+
+	std::vector<Fraction> expected = values;
+	std::sort( expected.begin(), expected.end(), exactLess );
+
+	std::vector<Fraction> sorted = values;
+	sortFractions( sorted );
+	CHECK( sameOrder( sorted, expected ) );
+
+	sorted = values;
+	sortFractionsParallel( sorted, 4 );
+	CHECK( sameOrder( sorted, expected ) );
+
+	// selection
+	std::vector<Fraction> selected = values;
+	size_t n = selected.size() / 3;
+	CHECK( nthFraction( selected, n ).compare( expected[n] ) == 0 );
+
+	// partitioning around a value inside a cluster
+	Fraction pivot( 1000000000000500LL, 1000000000000501LL );
+	std::vector<Fraction> partitioned = values;
+	size_t smaller = partitionFractions( partitioned, pivot );
+	size_t expectedSmaller = std::lower_bound( expected.begin(), expected.end(), pivot, exactLess ) - expected.begin();
+	CHECK( smaller == expectedSmaller );
+	bool split = true;
+	for ( size_t k = 0; k < partitioned.size(); k++ ) split = split && ( k < smaller ) == ( partitioned[k] < pivot );
+	CHECK( split );
+
+	return fractionTestResult();
+}
@@ -0,0 +1,108 @@
+//sliding-window statistics against a recomputed window
+
+#include <deque>
+#include <random>
+#include <stdexcept>
+
+#include "FractionStatistics.h"
+#include "FractionTest.h"
+
+int main()
+{
+	std::mt19937_64 random( 32 );
+
+	// every statistic matches the window recomputed from scratch, including after overflowing pushes
+	bool equal = true;
+	int overflows = 0;
+	for ( int run = 0; run < 50; run++ )
+	{
+		const size_t window = 1 + random() % 6;
+		FractionWindowStats stats( window );
+		std::deque<Fraction> reference;
+
+		for ( int k = 0; k < 300; k++ )
+		{
+			long long d = random() % 4 == 0 ? (long long)( random() % 3000000000ULL ) + 1 : (long long)( random() % 50 ) + 1;
+			Fraction f( (long long)( random() % 2001 ) - 1000, d );
+			try
+			{
+				stats.push( f );
+				reference.push_back( f );
+				if ( reference.size() > window ) reference.pop_front();
+			}
+			catch ( const std::overflow_error & )
+			{
+				overflows++;
+			}
+
+			equal = equal && stats.size() == reference.size();
+			try
+			{
+				Fraction sum( 0, 1 ), minimum = reference[0], maximum = reference[0];
+				for ( size_t i = 0; i < reference.size(); i++ )
+				{
+					sum.add( reference[i] );
+					if ( reference[i] < minimum ) minimum = reference[i];
+					if ( reference[i] > maximum ) maximum = reference[i];
+				}
+				equal = equal && stats.sum() == sum && stats.min() == minimum && stats.max() == maximum;
+			}
+			catch ( const std::overflow_error & )
+			{
+			}
+			try
+			{
+				Fraction squares( 0, 1 );
+				for ( size_t i = 0; i < reference.size(); i++ ) squares.add( reference[i] * reference[i] );
+				equal = equal && stats.sumOfSquares() == squares;
+			}
+			catch ( const std::overflow_error & )
+			{
+			}
+		}
+	}
+	CHECK( equal );
+	CHECK( overflows > 0 );
+
+	// squares that do not fit over D^2 leave the other statistics working
+	FractionWindowStats one( 4 );
+	one.push( Fraction( 1, 4000000000LL ) );
+	CHECK( one.sum() == Fraction( 1, 4000000000LL ) && one.mean() == Fraction( 1, 4000000000LL ) );
+	CHECK( one.min() == Fraction( 1, 4000000000LL ) && one.max() == Fraction( 1, 4000000000LL ) );
+	CHECK_THROWS( one.sumOfSquares(), std::overflow_error );
+
+	FractionWindowStats pair( 2 );
+	pair.push( Fraction( 1, 2 ) );
+	pair.push( Fraction( 1, 3 ) );
+	pair.push( Fraction( 3037000499LL, 3037000493LL ) );
+	CHECK( pair.size() == 2 && pair.min() == Fraction( 1, 3 ) );
+	CHECK( pair.sum() == Fraction( 1, 3 ) + Fraction( 3037000499LL, 3037000493LL ) );
+	CHECK_THROWS( pair.variance(), std::overflow_error );
+
+	// once the large value leaves, the squares are rebuilt
+	pair.push( Fraction( 1, 4 ) );
+	pair.push( Fraction( 1, 5 ) );
+	CHECK( pair.sumOfSquares() == Fraction( 41, 400 ) && pair.variance() == Fraction( 1, 1600 ) );
+
+	// a push whose sum overflows leaves the window as it was
+	FractionWindowStats wide( 3 );
+	wide.push( Fraction( 1, 3000000019LL ) );
+	wide.push( Fraction( 1, 3000000017LL ) );
+	CHECK_THROWS( wide.push( Fraction( 1, 3000000023LL ) ), std::overflow_error );
+	CHECK( wide.size() == 2 && wide.sum() == Fraction( 1, 3000000019LL ) + Fraction( 1, 3000000017LL ) );
+
+	// mean and variances
+	FractionWindowStats small( 4 );
+	small.push( Fraction( 1, 1 ) );
+	CHECK_THROWS( small.sampleVariance(), std::invalid_argument );
+	small.push( Fraction( 2, 1 ) );
+	small.push( Fraction( 4, 1 ) );
+	CHECK( small.mean() == Fraction( 7, 3 ) );
+	CHECK( small.variance() == Fraction( 14, 9 ) );
+	CHECK( small.sampleVariance() == Fraction( 7, 3 ) );
+
+	FractionWindowStats none( 3 );
+	CHECK_THROWS( none.mean(), std::invalid_argument );
+
+	return fractionTestResult();
+}